@@ -0,0 +1,84 @@
+// BenchUtil.h
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+// bench/ 下基准程序共用的计时、防优化与逐笔行情样本数据
+
+// 结果累加到这里, 防止被测代码被编译器整体优化掉
+inline volatile uint64_t g_bench_sink = 0;
+
+// 执行 fn 共 runs 次, 返回单次最短耗时(秒)
+template<typename Fn>
+double bestSeconds(int runs, Fn&& fn) {
+    double best = 1e300;
+    for (int i = 0; i < runs; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        fn();
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (seconds < best) {
+            best = seconds;
+        }
+    }
+    return best;
+}
+
+// 读取 convertTickJournalToText 输出的 *_order_tcp.txt / *_trade_tcp.txt, 每行一条记录
+inline std::vector<std::string> loadRecords(const std::string& path) {
+    std::vector<std::string> records;
+    std::ifstream in(path);
+    std::string line;
+    while (std::getline(in, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (!line.empty()) {
+            records.push_back(line);
+        }
+    }
+    return records;
+}
+
+// 无抓包数据时生成的逐笔委托记录, 字段布局与 L2Schema<L2Order, TcpLayout> 一致(13 个字段)
+inline std::vector<std::string> makeSyntheticOrderRecords(size_t count, unsigned seed = 1) {
+    static const char* const kSymbols[] = {"600000.SH", "600895.SH", "601318.SH", "000001.SZ", "000858.SZ", "300750.SZ"};
+
+    std::mt19937 rng(seed);
+    std::vector<std::string> records;
+    records.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        const char* symbol = kSymbols[rng() % 6];
+        int seq = static_cast<int>(i + 1);
+        int time = 93000000 + static_cast<int>(i / 50);
+        int price = 100000 + static_cast<int>(rng() % 2000) * 10;
+        int volume = 100 * (1 + static_cast<int>(rng() % 500));
+        records.push_back(std::to_string(seq) + "," + symbol + ",0,20250101," + std::to_string(time) + "," +
+            std::to_string(seq) + "," + std::to_string(price) + "," + std::to_string(volume) + ",2," +
+            std::to_string(1 + rng() % 2) + "," + std::to_string(seq) + ",0," + std::to_string(1 + rng() % 6));
+    }
+    return records;
+}
+
+// 按 TCP 推送格式拼帧: <rec#rec#...>, 每 records_per_frame 条一帧, 每 50 帧插入一个心跳帧
+inline std::string buildTcpStream(const std::vector<std::string>& records, size_t records_per_frame) {
+    std::string stream;
+    size_t frames = 0;
+    for (size_t i = 0; i < records.size(); i += records_per_frame) {
+        stream += '<';
+        for (size_t j = i; j < records.size() && j < i + records_per_frame; ++j) {
+            if (j != i) {
+                stream += '#';
+            }
+            stream += records[j];
+        }
+        stream += '>';
+        if (++frames % 50 == 0) {
+            stream += "<HeartBeat>";
+        }
+    }
+    return stream;
+}
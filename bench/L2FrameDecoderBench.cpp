@@ -0,0 +1,149 @@
+// L2FrameDecoderBench.cpp
+// 逐笔 TCP 分帧基准: L2FrameDecoder 与原 parseL2Data 的 append/substr 缓冲方式对比
+// 用法: L2FrameDecoderBench [*_order_tcp.txt | -] [分片字节数, 默认 8192]
+// 未给出抓包文件或为 - 时使用合成的逐笔委托记录; 输入按分片字节数切开, 模拟逐个 recv 分片
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "BenchUtil.h"
+#include "L2FrameDecoder.h"
+#include "L2Parser.h"
+#include "Logger.h"
+
+namespace {
+
+constexpr size_t kOrderFields = 13;
+constexpr int kRuns = 5;
+
+// 原 parseL2Data 的分帧与切分流程: 分片追加进缓冲区, 帧被切断时 substr 保留尾部,
+// 每条记录做 5 次控制帧 find 后 splitByComma; 只统计字段数匹配的记录, 不构造事件、不打日志
+size_t legacyParse(std::string_view data, std::string& buffer) {
+    size_t records = 0;
+    size_t pos = 0;
+
+    buffer.append(data);
+    std::string_view buffer_view = buffer;
+
+    auto is_control = [](std::string_view part) {
+        return part.find("HeartBeat") != std::string_view::npos ||
+            part.find("DY2") != std::string_view::npos ||
+            part.find("Order") != std::string_view::npos ||
+            part.find("Tran") != std::string_view::npos ||
+            part.find("Login") != std::string_view::npos;
+    };
+
+    while (pos < buffer.size()) {
+        size_t open = buffer_view.find('<', pos);
+        if (open == std::string_view::npos) {
+            buffer.clear();
+            buffer.append(data);
+            return records;
+        }
+
+        size_t close = buffer_view.find('>', open);
+        if (close == std::string_view::npos) {
+            buffer = buffer.substr(open);
+            return records;
+        }
+
+        std::string_view full_record = buffer_view.substr(open + 1, close - open - 1);
+        size_t start = 0;
+        while (start < full_record.size()) {
+            size_t end = full_record.find('#', start);
+            std::string_view part = full_record.substr(start, end == std::string_view::npos ? std::string_view::npos : end - start);
+            if (is_control(part)) {
+                break;
+            }
+            if (!part.empty() && splitByComma(part).size() == kOrderFields) {
+                ++records;
+            }
+            if (end == std::string_view::npos) {
+                break;
+            }
+            start = end + 1;
+        }
+
+        pos = close + 1;
+    }
+    buffer.clear();
+    return records;
+}
+
+std::vector<std::string_view> splitChunks(std::string_view stream, size_t chunk_bytes) {
+    std::vector<std::string_view> chunks;
+    for (size_t offset = 0; offset < stream.size(); offset += chunk_bytes) {
+        chunks.push_back(stream.substr(offset, chunk_bytes));
+    }
+    return chunks;
+}
+
+void report(const char* name, double seconds, size_t bytes, size_t records, double baseline) {
+    std::printf("%-28s %8.1f MB/s %10.0f 条/秒 %8.2fx\n",
+        name, bytes / seconds / 1e6, records / seconds, baseline / seconds);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    init_log_system("logs/bench.log");
+
+    const bool synthetic = argc < 2 || std::string_view(argv[1]) == "-";
+    std::vector<std::string> records = synthetic ? makeSyntheticOrderRecords(500000) : loadRecords(argv[1]);
+    const size_t chunk_bytes = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 8192;
+    if (records.empty() || chunk_bytes == 0) {
+        std::printf("无输入记录或分片字节数非法\n");
+        return 1;
+    }
+
+    const std::string stream = buildTcpStream(records, 20);
+    const std::vector<std::string_view> chunks = splitChunks(stream, chunk_bytes);
+    std::printf("记录 %zu 条, 数据 %zu 字节, 分片 %zu 字节 x %zu, 指令集 %s\n",
+        records.size(), stream.size(), chunk_bytes, chunks.size(), l2scan::isaLevelName(l2scan::activeIsaLevel()));
+
+    size_t legacy_records = 0;
+    double legacy = bestSeconds(kRuns, [&] {
+        std::string buffer;
+        legacy_records = 0;
+        for (std::string_view chunk : chunks) {
+            legacy_records += legacyParse(chunk, buffer);
+        }
+    });
+
+    size_t decoder_records = 0;
+    double decoder = bestSeconds(kRuns, [&] {
+        L2FrameDecoder frame_decoder;
+        decoder_records = 0;
+        for (std::string_view chunk : chunks) {
+            frame_decoder.feed(chunk, [&](const l2scan::L2RecordView& record) {
+                decoder_records += record.field_count == kOrderFields;
+            });
+        }
+    });
+
+    size_t parsed_events = 0;
+    double parsed = bestSeconds(kRuns, [&] {
+        L2FrameDecoder frame_decoder;
+        std::vector<MarketEvent> events;
+        parsed_events = 0;
+        for (std::string_view chunk : chunks) {
+            events.clear();
+            parseL2Data(chunk, DataMessage::MessageType::ORDER, 0, frame_decoder, nullptr, events);
+            parsed_events += events.size();
+        }
+    });
+    g_bench_sink += legacy_records + decoder_records + parsed_events;
+
+    std::printf("%-28s %13s %16s %9s\n", "", "吞吐", "记录", "加速比");
+    report("原 parseL2Data 分帧+切分", legacy, stream.size(), legacy_records, legacy);
+    report("L2FrameDecoder 分帧+切分", decoder, stream.size(), decoder_records, legacy);
+    report("parseL2Data 分帧+解析事件", parsed, stream.size(), parsed_events, legacy);
+
+    if (legacy_records != decoder_records) {
+        std::printf("记录数不一致: 原实现 %zu, L2FrameDecoder %zu\n", legacy_records, decoder_records);
+        return 1;
+    }
+    return 0;
+}
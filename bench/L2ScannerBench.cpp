@@ -0,0 +1,106 @@
+// L2ScannerBench.cpp
+// 分隔符扫描基准: 依次强制 AVX2 / SSE4.2 / 标量分派, 测各指令集级别的字节吞吐
+// 用法: L2ScannerBench [*_order_tcp.txt | -]
+// 未给出抓包文件或为 - 时使用合成的逐笔委托记录; 同一数据按 TCP 帧格式与 HTTP CSV 格式各测一遍
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "BenchUtil.h"
+#include "L2FrameDecoder.h"
+#include "L2Scanner.h"
+#include "Logger.h"
+
+namespace {
+
+constexpr int kRuns = 5;
+
+struct ScanResult {
+    double masks = 0;      // buildDelimiterMasks 位图生成
+    double delimiters = 0; // forEachDelimiter 逐个交付分隔符
+    double records = 0;    // 分帧/按行切分到字段
+    size_t delimiter_count = 0;
+    size_t record_count = 0;
+};
+
+ScanResult runLevel(const std::string& tcp_stream, const std::string& csv) {
+    ScanResult result;
+
+    std::vector<uint64_t> masks(tcp_stream.size() / l2scan::kBlockBytes);
+    result.masks = bestSeconds(kRuns, [&] {
+        l2scan::buildDelimiterMasks(tcp_stream.data(), masks.size(), masks.data());
+        g_bench_sink += masks.empty() ? 0 : masks.back();
+    });
+
+    result.delimiters = bestSeconds(kRuns, [&] {
+        size_t count = 0;
+        l2scan::forEachDelimiter(tcp_stream, [&](size_t, char) { ++count; });
+        result.delimiter_count = count;
+    });
+
+    result.records = bestSeconds(kRuns, [&] {
+        size_t count = 0;
+        L2FrameDecoder decoder;
+        decoder.feed(tcp_stream, [&](const l2scan::L2RecordView& record) { count += record.field_count; });
+        l2scan::forEachCsvRecord(csv, [&](const l2scan::L2RecordView& record) { count += record.field_count; });
+        result.record_count = count;
+    });
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    init_log_system("logs/bench.log");
+
+    const bool synthetic = argc < 2 || std::string_view(argv[1]) == "-";
+    std::vector<std::string> records = synthetic ? makeSyntheticOrderRecords(500000) : loadRecords(argv[1]);
+    if (records.empty()) {
+        std::printf("无输入记录\n");
+        return 1;
+    }
+
+    const std::string tcp_stream = buildTcpStream(records, 20);
+    std::string csv = "header\n";
+    for (const std::string& record : records) {
+        csv += record;
+        csv += '\n';
+    }
+
+    const l2scan::IsaLevel detected = l2scan::detectIsaLevel();
+    std::printf("记录 %zu 条, TCP %zu 字节, CSV %zu 字节, CPU 最高指令集 %s\n",
+        records.size(), tcp_stream.size(), csv.size(), l2scan::isaLevelName(detected));
+    std::printf("%-8s %14s %14s %18s\n", "指令集", "位图 MB/s", "分隔符 MB/s", "分帧+切分 MB/s");
+
+    const l2scan::IsaLevel levels[] = {l2scan::IsaLevel::AVX2, l2scan::IsaLevel::SSE42, l2scan::IsaLevel::SCALAR};
+    const char* reference = nullptr; // 首个实测的指令集, 其余级别的扫描结果须与之一致
+    size_t expected_delimiters = 0;
+    size_t expected_fields = 0;
+    bool consistent = true;
+    for (l2scan::IsaLevel level : levels) {
+        if (static_cast<int>(level) > static_cast<int>(detected) || !l2scan::setIsaLevel(level)) {
+            std::printf("%-8s 不支持, 跳过\n", l2scan::isaLevelName(level));
+            continue;
+        }
+
+        ScanResult result = runLevel(tcp_stream, csv);
+        const size_t mask_bytes = tcp_stream.size() / l2scan::kBlockBytes * l2scan::kBlockBytes;
+        std::printf("%-8s %14.1f %14.1f %18.1f\n", l2scan::isaLevelName(level),
+            mask_bytes / result.masks / 1e6,
+            tcp_stream.size() / result.delimiters / 1e6,
+            (tcp_stream.size() + csv.size()) / result.records / 1e6);
+
+        if (!reference) {
+            reference = l2scan::isaLevelName(level);
+            expected_delimiters = result.delimiter_count;
+            expected_fields = result.record_count;
+        } else if (result.delimiter_count != expected_delimiters || result.record_count != expected_fields) {
+            std::printf("%s 扫描结果与 %s 不一致\n", l2scan::isaLevelName(level), reference);
+            consistent = false;
+        }
+    }
+
+    l2scan::setIsaLevel(detected);
+    return consistent ? 0 : 1;
+}
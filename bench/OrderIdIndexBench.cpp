@@ -0,0 +1,252 @@
+// OrderIdIndexBench.cpp
+// 订单编号索引基准: OrderIdIndex 与 std::unordered_map<int, uint32_t> 对比
+// 用法: OrderIdIndexBench <数据目录> <合约代码>...   例如 OrderIdIndexBench data 600000.SH 000001.SZ
+//       OrderIdIndexBench [- [操作数, 默认 5000000]]
+// 回放模式读取 convertTickJournalToText 输出的 <代码>_order_tcp.txt / <代码>_trade_tcp.txt,
+// 按 OrderBook 的处理方式把全天逐笔转为索引操作: 限价委托按 order.id 插入, 成交与撤单查找买卖双方编号,
+// 全部成交或撤完的订单删除; 未给出数据目录或为 - 时改用合成编号序列:
+// 同一通道的编号递增, 分给本合约的编号之间有间隔(沪市间隔较大, 深市较密), 另有少量窗口外的离群编号
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "BenchUtil.h"
+#include "L2Parser.h"
+#include "Logger.h"
+#include "MarketPolicy.h"
+#include "OrderIdIndex.h"
+
+namespace {
+
+constexpr int kRuns = 3;
+constexpr size_t kResting = 20000; // 稳态在簿订单数
+
+struct Op {
+    enum Kind : uint8_t { INSERT, FIND, ERASE } kind;
+    int id;
+    uint32_t slot;
+};
+
+struct Profile {
+    const char* name;
+    int max_gap;        // 相邻编号的最大间隔
+    int outlier_permil; // 离群编号占插入的千分比
+};
+
+std::vector<Op> makeOps(const Profile& profile, size_t count, unsigned seed = 1) {
+    std::mt19937 rng(seed);
+    std::vector<Op> ops;
+    ops.reserve(count);
+    std::vector<int> live;
+    int next_id = 1000000 + static_cast<int>(rng() % 1000);
+    int early_id = next_id;            // 早于窗口起点的离群编号, 递减
+    int far_id = next_id + (1 << 27);  // 超出窗口跨度的离群编号, 递增
+    uint32_t next_slot = 0;
+
+    while (ops.size() < count) {
+        const unsigned r = rng() % 100;
+        if (live.size() < kResting / 2 || (r < 40 && live.size() < kResting * 2)) {
+            int id;
+            if (static_cast<int>(rng() % 1000) < profile.outlier_permil) {
+                // 离群编号: 早于窗口起点或远超窗口跨度, 各自单调以免重复
+                id = rng() % 2 ? (early_id -= 1 + static_cast<int>(rng() % 64)) : (far_id += 1 + static_cast<int>(rng() % 4096));
+            } else {
+                next_id += 1 + static_cast<int>(rng() % profile.max_gap);
+                id = next_id;
+            }
+            live.push_back(id);
+            ops.push_back({Op::INSERT, id, next_slot++});
+        } else if (r < 75) {
+            // 成交/撤单查找, 约三分之一的对手方编号不在本簿中
+            int id = rng() % 3 == 0 ? next_id - static_cast<int>(rng() % 100000) : live[rng() % live.size()];
+            ops.push_back({Op::FIND, id, 0});
+        } else {
+            size_t pos = rng() % live.size();
+            ops.push_back({Op::ERASE, live[pos], 0});
+            live[pos] = live.back();
+            live.pop_back();
+        }
+    }
+    return ops;
+}
+
+// 读取一个合约的逐笔委托与逐笔成交, 按时间戳合并; 同一毫秒内委托排在成交之前
+std::vector<MarketEvent> loadSymbolEvents(const std::string& dir, const std::string& symbol) {
+    std::vector<MarketEvent> events;
+    const std::pair<const char*, DataMessage::MessageType> streams[] = {
+        {"_order_tcp.txt", DataMessage::MessageType::ORDER},
+        {"_trade_tcp.txt", DataMessage::MessageType::TRADE},
+    };
+    for (const auto& [suffix, type] : streams) {
+        const std::string path = dir + "/" + symbol + suffix;
+        const std::vector<std::string> records = loadRecords(path);
+        if (records.empty()) {
+            std::printf("%s 无记录\n", path.c_str());
+            continue;
+        }
+        L2FrameDecoder decoder;
+        parseL2Data(buildTcpStream(records, 20), type, 0, decoder, nullptr, events);
+    }
+
+    auto timestamp = [](const MarketEvent& event) {
+        return event.type == MarketEvent::EventType::ORDER ? event.order.timestamp : event.trade.timestamp;
+    };
+    std::stable_sort(events.begin(), events.end(), [&](const MarketEvent& a, const MarketEvent& b) {
+        return timestamp(a) < timestamp(b);
+    });
+    return events;
+}
+
+// 按 OrderBook 的处理方式把逐笔事件转为索引操作, 剩余量在生成时跟踪;
+// 乱序到达的成交/撤单只记一次查找, 不模拟 PendingMatchStore 的暂存与补处理
+std::vector<Op> makeReplayOps(const std::vector<MarketEvent>& events, bool sse) {
+    std::vector<Op> ops;
+    ops.reserve(events.size() * 2);
+    std::unordered_map<int, int> remaining;
+    uint32_t next_slot = 0;
+
+    auto reduce = [&](int id, int volume) {
+        if (id == 0) {
+            return;
+        }
+        ops.push_back({Op::FIND, id, 0});
+        auto it = remaining.find(id);
+        if (it != remaining.end() && (it->second -= volume) <= 0) {
+            ops.push_back({Op::ERASE, id, 0});
+            remaining.erase(it);
+        }
+    };
+
+    for (const MarketEvent& event : events) {
+        if (event.type == MarketEvent::EventType::ORDER) {
+            const L2Order& order = event.order;
+            if (sse && order.type == 10) {
+                reduce(order.id, order.volume);
+            } else if (order.type == 2 && remaining.emplace(order.id, order.volume).second) {
+                ops.push_back({Op::INSERT, order.id, next_slot++});
+            }
+            continue;
+        }
+
+        const L2Trade& trade = event.trade;
+        reduce(trade.buy_id, trade.volume);
+        if (trade.sell_id != trade.buy_id) {
+            reduce(trade.sell_id, trade.volume);
+        }
+    }
+    return ops;
+}
+
+// 对查不到的编号统一返回 kNullSlot, 两种实现的结果摘要可直接比较
+struct MapIndex {
+    std::unordered_map<int, uint32_t> map;
+
+    uint64_t apply(const Op& op) {
+        switch (op.kind) {
+        case Op::INSERT:
+            map[op.id] = op.slot;
+            return 0;
+        case Op::FIND: {
+            auto it = map.find(op.id);
+            return it != map.end() ? it->second : kNullSlot;
+        }
+        case Op::ERASE: {
+            auto it = map.find(op.id);
+            if (it == map.end()) {
+                return kNullSlot;
+            }
+            uint32_t slot = it->second;
+            map.erase(it);
+            return slot;
+        }
+        }
+        return 0;
+    }
+};
+
+struct PagedIndex {
+    OrderIdIndex index;
+
+    uint64_t apply(const Op& op) {
+        switch (op.kind) {
+        case Op::INSERT:
+            index.exchange(op.id, op.slot);
+            return 0;
+        case Op::FIND:
+            return index.find(op.id);
+        case Op::ERASE:
+            return index.erase(op.id);
+        }
+        return 0;
+    }
+};
+
+template<typename Index>
+double replay(const std::vector<Op>& ops, uint64_t& digest) {
+    return bestSeconds(kRuns, [&] {
+        Index index;
+        uint64_t sum = 0;
+        for (const Op& op : ops) {
+            sum += index.apply(op);
+        }
+        digest = sum;
+    });
+}
+
+// 两种实现回放同一操作序列并输出一行结果, 查找结果摘要不一致时返回 false
+bool runWorkload(const std::string& name, const std::vector<Op>& ops) {
+    uint64_t map_digest = 0;
+    uint64_t index_digest = 0;
+    const double map_seconds = replay<MapIndex>(ops, map_digest);
+    const double index_seconds = replay<PagedIndex>(ops, index_digest);
+    g_bench_sink += map_digest + index_digest;
+
+    std::printf("%-24s %10zu %18.1f %18.1f %7.2fx\n", name.c_str(), ops.size(),
+        map_seconds / ops.size() * 1e9, index_seconds / ops.size() * 1e9, map_seconds / index_seconds);
+    if (map_digest != index_digest) {
+        std::printf("%s: 查找结果不一致\n", name.c_str());
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    init_log_system("logs/bench.log");
+
+    bool consistent = true;
+    if (argc >= 3 && std::string_view(argv[1]) != "-") {
+        std::printf("全天逐笔回放, 数据目录 %s\n", argv[1]);
+        std::printf("%-24s %10s %18s %18s %8s\n", "合约", "操作数", "unordered_map ns/次", "OrderIdIndex ns/次", "加速比");
+        for (int i = 2; i < argc; ++i) {
+            const std::vector<Op> ops = makeReplayOps(loadSymbolEvents(argv[1], argv[i]), isSseSymbol(argv[i]));
+            if (ops.empty()) {
+                std::printf("%s 无可回放的操作\n", argv[i]);
+                consistent = false;
+                continue;
+            }
+            consistent = runWorkload(argv[i], ops) && consistent;
+        }
+        return consistent ? 0 : 1;
+    }
+
+    const size_t count = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 5000000;
+    const Profile profiles[] = {
+        {"沪市(编号间隔 1~64)", 64, 5},
+        {"深市(编号间隔 1~8)", 8, 5},
+        {"离群编号 5%", 8, 50},
+    };
+
+    std::printf("未给出数据目录, 使用合成编号序列, 稳态在簿约 %zu 笔\n", kResting);
+    std::printf("%-24s %10s %18s %18s %8s\n", "编号分布", "操作数", "unordered_map ns/次", "OrderIdIndex ns/次", "加速比");
+    for (const Profile& profile : profiles) {
+        consistent = runWorkload(profile.name, makeOps(profile, count)) && consistent;
+    }
+    return consistent ? 0 : 1;
+}
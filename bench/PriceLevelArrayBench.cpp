@@ -0,0 +1,227 @@
+// PriceLevelArrayBench.cpp
+// 价格档位基准: PriceLevelArray<IntrusiveFifo> 与原 std::map<int, std::list> + 档位量 std::map 对比
+// 用法: PriceLevelArrayBench [操作数, 默认 5000000]
+// 操作序列预先生成(挂单/部分成交/撤单), 两种实现回放同一序列, 每次操作后取买一卖一价量;
+// 订单编号到订单位置用按编号下标的数组, 只比较档位部分, 订单索引的对比见 OrderIdIndexBench
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <list>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "BenchUtil.h"
+#include "PriceLevelArray.h"
+#include "SlabArena.h"
+
+namespace {
+
+constexpr int kRuns = 3;
+constexpr size_t kResting = 20000; // 稳态在簿订单数
+constexpr int kTick = 100;
+
+struct Op {
+    enum Kind : uint8_t { ADD, REDUCE, REMOVE } kind;
+    uint8_t side;  // 1 买 2 卖
+    int id;
+    int price;
+    int volume;    // ADD 为挂单量, REDUCE 为减少量
+};
+
+struct LiveOrder {
+    int id;
+    int side;
+    int price;
+    int volume;
+};
+
+// 买盘 9.00~10.00 元, 卖盘 10.01~11.00 元, 价格集中在中间价附近
+std::vector<Op> makeOps(size_t count, unsigned seed = 1) {
+    std::mt19937 rng(seed);
+    std::vector<Op> ops;
+    ops.reserve(count);
+    std::vector<LiveOrder> live;
+    int next_id = 0;
+
+    while (ops.size() < count) {
+        const unsigned r = rng() % 100;
+        if (live.size() < kResting / 2 || (r < 50 && live.size() < kResting * 2)) {
+            int side = 1 + static_cast<int>(rng() % 2);
+            int offset = static_cast<int>(std::abs(static_cast<int>(rng() % 101) - static_cast<int>(rng() % 101)));
+            int price = side == 1 ? 100000 - offset * kTick : 100100 + offset * kTick;
+            int volume = 100 * (1 + static_cast<int>(rng() % 50));
+            live.push_back({next_id, side, price, volume});
+            ops.push_back({Op::ADD, static_cast<uint8_t>(side), next_id, price, volume});
+            ++next_id;
+            continue;
+        }
+
+        size_t pos = rng() % live.size();
+        LiveOrder& order = live[pos];
+        if (r < 80 && order.volume > 100) {
+            int reduce = 100 * (1 + static_cast<int>(rng() % (order.volume / 100)));
+            if (reduce < order.volume) {
+                order.volume -= reduce;
+                ops.push_back({Op::REDUCE, static_cast<uint8_t>(order.side), order.id, order.price, reduce});
+                continue;
+            }
+        }
+        ops.push_back({Op::REMOVE, static_cast<uint8_t>(order.side), order.id, order.price, order.volume});
+        live[pos] = live.back();
+        live.pop_back();
+    }
+    return ops;
+}
+
+// 原实现: 每边一个 std::map<价格, std::list<订单>> 与一个 std::map<价格, 档位量>
+struct MapBook {
+    struct Order {
+        int id;
+        int volume;
+    };
+    using Levels = std::map<int, std::list<Order>>;
+
+    struct Side {
+        Levels levels;
+        std::map<int, int> volume_at_price;
+    };
+
+    Side sides[2];
+    std::vector<std::list<Order>::iterator> where;
+
+    explicit MapBook(size_t max_id) : where(max_id) {}
+
+    uint64_t apply(const Op& op) {
+        Side& side = sides[op.side - 1];
+        if (op.kind == Op::ADD) {
+            auto& queue = side.levels[op.price];
+            where[op.id] = queue.insert(queue.end(), {op.id, op.volume});
+            side.volume_at_price[op.price] += op.volume;
+        } else {
+            auto it = where[op.id];
+            it->volume -= op.volume;
+            auto vol_it = side.volume_at_price.find(op.price);
+            vol_it->second -= op.volume;
+            if (vol_it->second == 0) {
+                side.volume_at_price.erase(vol_it);
+            }
+            if (op.kind == Op::REMOVE) {
+                auto level_it = side.levels.find(op.price);
+                level_it->second.erase(it);
+                if (level_it->second.empty()) {
+                    side.levels.erase(level_it);
+                }
+            }
+        }
+
+        uint64_t digest = 0;
+        if (!sides[0].volume_at_price.empty()) {
+            auto best_bid = std::prev(sides[0].volume_at_price.end());
+            digest += best_bid->first + best_bid->second;
+        }
+        if (!sides[1].volume_at_price.empty()) {
+            auto best_ask = sides[1].volume_at_price.begin();
+            digest += best_ask->first + best_ask->second;
+        }
+        return digest;
+    }
+};
+
+// 现实现: PriceLevelArray 档位内联总量, 订单节点在 SlabArena 中以 IntrusiveFifo 排队
+struct ArrayBook {
+    struct Node {
+        int id;
+        int volume;
+        uint32_t prev;
+        uint32_t next;
+    };
+
+    PriceLevelArray<IntrusiveFifo> sides[2];
+    SlabArena<Node> pool;
+    std::vector<uint32_t> where;
+
+    explicit ArrayBook(size_t max_id) : sides{PriceLevelArray<IntrusiveFifo>(kTick), PriceLevelArray<IntrusiveFifo>(kTick)}, where(max_id) {
+        sides[0].reserve(90000, 100000);
+        sides[1].reserve(100100, 110100);
+    }
+
+    uint64_t apply(const Op& op) {
+        PriceLevelArray<IntrusiveFifo>& side = sides[op.side - 1];
+        if (op.kind == Op::ADD) {
+            uint32_t slot = pool.allocate();
+            pool[slot].id = op.id;
+            pool[slot].volume = op.volume;
+            auto* level = side.obtain(op.price);
+            level->orders.push_back(pool, slot);
+            level->order_count += 1;
+            side.addVolume(op.price, op.volume);
+            where[op.id] = slot;
+        } else {
+            uint32_t slot = where[op.id];
+            pool[slot].volume -= op.volume;
+            side.addVolume(op.price, -op.volume);
+            if (op.kind == Op::REMOVE) {
+                auto* level = side.find(op.price);
+                level->orders.erase(pool, slot);
+                level->order_count -= 1;
+                pool.release(slot);
+            }
+        }
+
+        uint64_t digest = 0;
+        int best_bid = sides[0].highestPrice();
+        if (best_bid != kInvalidPrice) {
+            digest += best_bid + sides[0].volumeAt(best_bid);
+        }
+        int best_ask = sides[1].lowestPrice();
+        if (best_ask != kInvalidPrice) {
+            digest += best_ask + sides[1].volumeAt(best_ask);
+        }
+        return digest;
+    }
+};
+
+template<typename Book>
+double replay(const std::vector<Op>& ops, size_t max_id, uint64_t& digest) {
+    return bestSeconds(kRuns, [&] {
+        Book book(max_id);
+        uint64_t sum = 0;
+        for (const Op& op : ops) {
+            sum += book.apply(op);
+        }
+        digest = sum;
+    });
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 5000000;
+    const std::vector<Op> ops = makeOps(count);
+
+    size_t max_id = 0;
+    for (const Op& op : ops) {
+        if (static_cast<size_t>(op.id) >= max_id) {
+            max_id = op.id + 1;
+        }
+    }
+
+    uint64_t map_digest = 0;
+    uint64_t array_digest = 0;
+    const double map_seconds = replay<MapBook>(ops, max_id, map_digest);
+    const double array_seconds = replay<ArrayBook>(ops, max_id, array_digest);
+    g_bench_sink += map_digest + array_digest;
+
+    std::printf("操作 %zu 次, 稳态在簿约 %zu 笔, 每边 101 个价位\n", ops.size(), kResting);
+    std::printf("%-34s %10.1f ns/次 %12.0f 次/秒\n", "std::map + std::list + 档位量 map",
+        map_seconds / ops.size() * 1e9, ops.size() / map_seconds);
+    std::printf("%-34s %10.1f ns/次 %12.0f 次/秒 %6.2fx\n", "PriceLevelArray + IntrusiveFifo",
+        array_seconds / ops.size() * 1e9, ops.size() / array_seconds, map_seconds / array_seconds);
+
+    if (map_digest != array_digest) {
+        std::printf("买一卖一校验不一致\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,142 @@
+// RouteBatchBench.cpp
+// DataRouter --> OrderBook 批量投递基准: 不同 route_batch_size 下的端到端事件吞吐(条/秒)
+// 用法: RouteBatchBench [每个 OrderBook 的事件数, 默认 200000] [drain_limit, 默认 512] [spsc]
+// 主线程扮演 DataRouter, 按批大小轮流向各 OrderBook pushEvents; ShardWorkerPool 处理线程 poll() 消费,
+// 计时到全部 OrderBook 的已处理实时事件数(快照 loop_count)达到投递数为止
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "BenchUtil.h"
+#include "Logger.h"
+#include "OrderBook.h"
+#include "ShardWorkerPool.h"
+#include "SymbolTable.h"
+
+namespace {
+
+constexpr size_t kBooks = 8;
+constexpr size_t kWorkers = 2;
+constexpr int kResting = 100; // 每个 OrderBook 保持的挂单数, 新单到达时撤掉最早的一笔
+
+// 单个上交所 OrderBook 的实时事件: 挂单与撤单交替, 订单簿规模保持不变
+std::vector<MarketEvent> makeEvents(SymbolId symbol_id, size_t count) {
+    std::vector<MarketEvent> events;
+    events.reserve(count);
+    int next_id = 1;
+    while (events.size() < count) {
+        L2Order order{};
+        order.symbol_id = symbol_id;
+        order.id = order.num1 = order.num2 = next_id;
+        order.price = 100000 + (next_id % 50) * 100;
+        order.volume = 100 * (1 + next_id % 10);
+        order.side = 1 + next_id % 2;
+        order.type = 2;
+        order.timestamp = 33000000; // 09:10, 不触发撤单与卖出策略
+        order.channel = 1;
+        events.emplace_back(order);
+
+        if (next_id > kResting && events.size() < count) {
+            L2Order cancel = order;
+            cancel.id = cancel.num1 = cancel.num2 = next_id - kResting;
+            cancel.type = 10;
+            cancel.price = 100000 + (cancel.id % 50) * 100;
+            cancel.volume = 100 * (1 + cancel.id % 10);
+            cancel.side = 1 + cancel.id % 2;
+            events.emplace_back(cancel);
+        }
+        ++next_id;
+    }
+    return events;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    init_log_system("logs/bench.log");
+
+    const size_t events_per_book = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200000;
+    PipelineConfig pipeline_config;
+    pipeline_config.drain_limit = argc > 2 ? std::atoi(argv[2]) : pipeline_config.drain_limit;
+    if (argc > 3 && std::string_view(argv[3]) == "spsc") {
+        pipeline_config.queue_type = QueueType::SPSC;
+    }
+    PriceBandConfig price_band_config;
+
+    SendServer send_server("bench_send");
+    SendServer queue_send_server("bench_queue");
+    AutoSaveJsonMap<std::string, std::vector<int>> cancel_monitor("logs/bench_cancel.json");
+    AutoSaveJsonMap<std::string, std::unordered_map<int, int>> sell_monitor("logs/bench_sell.json");
+    AutoSaveJsonMap<std::string, std::vector<int>> queue_monitor("logs/bench_queue.json");
+
+    std::vector<std::string> symbols;
+    std::vector<std::vector<MarketEvent>> events;
+    for (size_t i = 0; i < kBooks; ++i) {
+        symbols.push_back(std::to_string(600000 + i) + ".SH");
+        events.push_back(makeEvents(SymbolTable::instance().intern(symbols.back()), events_per_book));
+    }
+
+    // 处理线程的定时打印与结果交错, 结果统一在最后输出
+    const size_t batch_sizes[] = {1, 4, 16, 64, 256, 1024};
+    std::vector<double> rates;
+    for (size_t batch_size : batch_sizes) {
+        std::vector<std::unique_ptr<OrderBookBase>> books;
+        for (const std::string& symbol : symbols) {
+            books.push_back(makeOrderBook(symbol, 0, pipeline_config, price_band_config,
+                send_server, queue_send_server, cancel_monitor, sell_monitor, queue_monitor));
+            books.back()->is_history_order_done_ = true;
+            books.back()->is_history_trade_done_ = true;
+        }
+
+        ShardWorkerPool pool(kWorkers, ThreadRole{});
+        for (size_t i = 0; i < kBooks; ++i) {
+            pool.attach(books[i].get(), SymbolTable::instance().find(symbols[i]));
+            books[i]->schedule(); // 无历史数据, 立即切换到实时阶段
+        }
+        for (auto& book : books) {
+            while (!book->snapshot().live) {
+                std::this_thread::yield();
+            }
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t offset = 0; offset < events_per_book; offset += batch_size) {
+            const size_t count = std::min(batch_size, events_per_book - offset);
+            for (size_t i = 0; i < kBooks; ++i) {
+                // SPSC 环形缓冲区满时事件已暂存在生产者侧, 以空批次补投完再继续
+                if (!books[i]->pushEvents(0, events[i].data() + offset, count)) {
+                    while (!books[i]->pushEvents(0, nullptr, 0)) {
+                        std::this_thread::yield();
+                    }
+                }
+            }
+        }
+        for (auto& book : books) {
+            while (static_cast<size_t>(book->snapshot().loop_count) < events_per_book) {
+                std::this_thread::yield();
+            }
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        pool.stop();
+        rates.push_back(kBooks * events_per_book / seconds);
+    }
+
+    send_server.stop();
+    queue_send_server.stop();
+
+    std::printf("OrderBook %zu 个, 处理线程 %zu 个, 每个 OrderBook %zu 条, drain_limit %d, 队列 %s\n",
+        kBooks, kWorkers, events_per_book, pipeline_config.drain_limit,
+        pipeline_config.queue_type == QueueType::SPSC ? "spsc" : "moodycamel");
+    std::printf("%10s %14s\n", "批大小", "条/秒");
+    for (size_t i = 0; i < rates.size(); ++i) {
+        std::printf("%10zu %14.0f\n", batch_sizes[i], rates[i]);
+    }
+    return 0;
+}
@@ -0,0 +1,201 @@
+// SpscQueueBench.cpp
+// 单生产者单消费者队列基准: SpscRingBuffer(各等待方式) 与 moodycamel 队列的吞吐与单程延迟对比
+// 用法: SpscQueueBench [吞吐测试事件数, 默认 20000000] [延迟测试往返次数, 默认 200000]
+// 吞吐: 生产者每批 64 条 MarketEvent, 消费者每次最多取 256 条;
+// 延迟: 两个队列乒乓往返, 单程延迟取往返时间的一半, 报告中位数与 p99
+// spin / busy_poll 要求两端线程各占一个核心, 核心数不足时这两行结果没有参考意义
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "BenchUtil.h"
+#include "concurrentqueue/blockingconcurrentqueue.h"
+#include "DataStruct.h"
+#include "SpscRingBuffer.h"
+#include "WaitStrategy.h"
+
+namespace {
+
+constexpr size_t kPushBatch = 64;
+constexpr size_t kPopBatch = 256;
+constexpr size_t kRingCapacity = 65536; // 与 [pipeline] ring_capacity 默认值一致
+
+MarketEvent makeEvent(size_t seq) {
+    L2Order order{};
+    order.num1 = static_cast<int>(seq);
+    return MarketEvent(order);
+}
+
+// 消费者按序号校验, 乱序或丢失时返回 false
+double spscThroughput(WaitMode mode, size_t count, bool& ok) {
+    SpscRingBuffer<MarketEvent> ring(kRingCapacity);
+    WaitStrategy waiter(mode);
+    ok = true;
+
+    return bestSeconds(1, [&] {
+        std::thread consumer([&] {
+            std::vector<MarketEvent> buffer(kPopBatch);
+            size_t received = 0;
+            while (received < count) {
+                waiter.waitUntil([&] { return !ring.empty(); });
+                size_t n = ring.try_pop_bulk(buffer.data(), buffer.size());
+                for (size_t i = 0; i < n; ++i) {
+                    ok &= buffer[i].order.num1 == static_cast<int>(received + i);
+                }
+                received += n;
+            }
+        });
+
+        std::vector<MarketEvent> batch(kPushBatch);
+        for (size_t next = 0; next < count;) {
+            const size_t n = std::min(kPushBatch, count - next);
+            for (size_t i = 0; i < n; ++i) {
+                batch[i] = makeEvent(next + i);
+            }
+            for (size_t pushed = 0; pushed < n;) {
+                pushed += ring.try_push_bulk(batch.data() + pushed, n - pushed);
+                waiter.notify();
+                if (pushed < n) {
+                    std::this_thread::yield();
+                }
+            }
+            next += n;
+        }
+        consumer.join();
+    });
+}
+
+// bulk 为 false 时逐条 enqueue / wait_dequeue, 即改造前 DataRouter --> OrderBook 的用法
+double moodycamelThroughput(size_t count, bool bulk) {
+    moodycamel::BlockingConcurrentQueue<MarketEvent> queue;
+
+    return bestSeconds(1, [&] {
+        std::thread consumer([&] {
+            std::vector<MarketEvent> buffer(kPopBatch);
+            size_t received = 0;
+            while (received < count) {
+                if (bulk) {
+                    received += queue.wait_dequeue_bulk(buffer.data(), buffer.size());
+                } else {
+                    queue.wait_dequeue(buffer[0]);
+                    ++received;
+                }
+            }
+            g_bench_sink += buffer[0].order.num1;
+        });
+
+        std::vector<MarketEvent> batch(kPushBatch);
+        for (size_t next = 0; next < count;) {
+            const size_t n = std::min(kPushBatch, count - next);
+            for (size_t i = 0; i < n; ++i) {
+                batch[i] = makeEvent(next + i);
+            }
+            if (bulk) {
+                queue.enqueue_bulk(batch.data(), n);
+            } else {
+                for (size_t i = 0; i < n; ++i) {
+                    queue.enqueue(batch[i]);
+                }
+            }
+            next += n;
+        }
+        consumer.join();
+    });
+}
+
+struct Latency {
+    double median_ns = 0;
+    double p99_ns = 0;
+};
+
+Latency summarize(std::vector<double>& one_way_ns) {
+    std::sort(one_way_ns.begin(), one_way_ns.end());
+    return {one_way_ns[one_way_ns.size() / 2], one_way_ns[one_way_ns.size() * 99 / 100]};
+}
+
+Latency spscLatency(WaitMode mode, size_t rounds) {
+    SpscRingBuffer<MarketEvent> ping(kRingCapacity), pong(kRingCapacity);
+    WaitStrategy ping_waiter(mode), pong_waiter(mode);
+
+    std::thread echo([&] {
+        MarketEvent event;
+        for (size_t i = 0; i < rounds; ++i) {
+            ping_waiter.waitUntil([&] { return !ping.empty(); });
+            ping.try_pop_bulk(&event, 1);
+            pong.try_push(event);
+            pong_waiter.notify();
+        }
+    });
+
+    std::vector<double> one_way_ns(rounds);
+    MarketEvent event;
+    for (size_t i = 0; i < rounds; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        ping.try_push(makeEvent(i));
+        ping_waiter.notify();
+        pong_waiter.waitUntil([&] { return !pong.empty(); });
+        pong.try_pop_bulk(&event, 1);
+        one_way_ns[i] = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / 2;
+    }
+    echo.join();
+    return summarize(one_way_ns);
+}
+
+Latency moodycamelLatency(size_t rounds) {
+    moodycamel::BlockingConcurrentQueue<MarketEvent> ping, pong;
+
+    std::thread echo([&] {
+        MarketEvent event;
+        for (size_t i = 0; i < rounds; ++i) {
+            ping.wait_dequeue(event);
+            pong.enqueue(event);
+        }
+    });
+
+    std::vector<double> one_way_ns(rounds);
+    MarketEvent event;
+    for (size_t i = 0; i < rounds; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        ping.enqueue(makeEvent(i));
+        pong.wait_dequeue(event);
+        one_way_ns[i] = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / 2;
+    }
+    echo.join();
+    return summarize(one_way_ns);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 20000000;
+    const size_t rounds = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 200000;
+    if (count == 0 || rounds == 0) {
+        std::printf("事件数与往返次数须大于 0\n");
+        return 1;
+    }
+
+    std::printf("MarketEvent %zu 字节, 吞吐 %zu 条, 延迟 %zu 次往返\n", sizeof(MarketEvent), count, rounds);
+    std::printf("%-22s %12s %14s %12s\n", "队列", "吞吐 M/s", "单程中位 ns", "单程 p99 ns");
+
+    bool all_ok = true;
+    const WaitMode modes[] = {WaitMode::BLOCK, WaitMode::SPIN_THEN_PARK, WaitMode::BUSY_POLL};
+    for (WaitMode mode : modes) {
+        bool ok = false;
+        double seconds = spscThroughput(mode, count, ok);
+        Latency latency = spscLatency(mode, rounds);
+        std::printf("spsc/%-17s %12.1f %14.0f %12.0f%s\n", waitModeName(mode),
+            count / seconds / 1e6, latency.median_ns, latency.p99_ns, ok ? "" : "  顺序校验失败");
+        all_ok &= ok;
+    }
+
+    Latency latency = moodycamelLatency(rounds);
+    std::printf("%-22s %12.1f %14.0f %12.0f\n", "moodycamel/bulk",
+        count / moodycamelThroughput(count, true) / 1e6, latency.median_ns, latency.p99_ns);
+    std::printf("%-22s %12.1f %14s %12s\n", "moodycamel/逐条",
+        count / moodycamelThroughput(count, false) / 1e6, "-", "-");
+
+    return all_ok ? 0 : 1;
+}
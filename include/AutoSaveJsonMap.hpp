@@ -1,4 +1,5 @@
 #pragma once
+#include <atomic>
 #include <fstream>
 #include <map>
 #include <list>
@@ -26,9 +27,15 @@ public:
     void set(const Key& key, Value value) {
         std::unique_lock<std::shared_mutex> lock(mtx_);
         data_[key] = std::move(value);
+        version_.fetch_add(1, std::memory_order_release);
         saveUnsafe();
     }   
 
+    // 每次 set 后递增, 读取方可据此判断缓存的值是否需要重新 get
+    uint64_t version() const {
+        return version_.load(std::memory_order_acquire);
+    }
+
     // 读操作：共享锁（多个读可并发）
     std::optional<Value> get(const Key& key) const {
         std::shared_lock<std::shared_mutex> lock(mtx_);
@@ -51,6 +58,7 @@ private:
     mutable std::shared_mutex mtx_;
     std::string filename_;
     MapType data_;
+    std::atomic<uint64_t> version_{0};
 
     void load() {
         std::ifstream file(filename_);
@@ -0,0 +1,37 @@
+// BookSnapshot.h
+#pragma once
+#include <cstddef>
+
+#include "OrderIdIndex.h"
+#include "PendingMatchStore.h"
+
+// 订单簿对外发布的只读快照: 前 kDepth 档盘口与计数器
+// 由处理线程每处理完一批事件发布一次, 打印与查询只读快照, 不访问订单簿本身
+struct BookSnapshot {
+    static constexpr int kDepth = 10;
+
+    struct Level {
+        int price;
+        int volume;
+    };
+
+    Level bids[kDepth];  // 买盘, 价格从高到低
+    Level asks[kDepth];  // 卖盘, 价格从低到高
+    int bid_levels = 0;  // bids 中有效档数
+    int ask_levels = 0;  // asks 中有效档数
+
+    int fengdan_volume = 0;       // 当前封单量
+    int max_bid_volume = 0;       // 最大封单量
+    int last_event_timestamp = 0; // 最后一笔事件的时间戳
+    long loop_count = 0;          // 已处理的实时事件数
+    bool live = false;            // 历史数据已回放完毕
+
+    // 订单节点池
+    size_t pool_live = 0;
+    size_t pool_peak = 0;
+    size_t pool_capacity = 0;
+    size_t pool_chunk_allocations = 0;
+
+    OrderIdIndex::Stats index_stats;
+    PendingMatchStore::Stats pending_stats;
+};
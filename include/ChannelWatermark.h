@@ -0,0 +1,41 @@
+// ChannelWatermark.h
+#pragma once
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// 每个交易通道已覆盖的最大逐笔序号
+// 同一通道内逐笔序号连续递增, 历史数据回放时记录各通道最大序号, 之后实时事件序号不超过该值即已由历史数据处理过;
+// 按通道号直接下标访问, 只在回放阶段扩容, 判断重复为一次数组访问
+class ChannelWatermark {
+public:
+    void observe(uint16_t channel, int seq) {
+        if (channel >= marks_.size()) {
+            marks_.resize(static_cast<size_t>(channel) + 1, kNone);
+        }
+        if (seq > marks_[channel]) {
+            marks_[channel] = seq;
+        }
+    }
+
+    bool covers(uint16_t channel, int seq) const {
+        return channel < marks_.size() && seq <= marks_[channel];
+    }
+
+    // 有记录的通道数
+    size_t channels() const {
+        size_t count = 0;
+        for (int mark : marks_) {
+            if (mark != kNone) {
+                ++count;
+            }
+        }
+        return count;
+    }
+
+private:
+    static constexpr int kNone = INT_MIN;
+
+    std::vector<int> marks_; // 通道号 -> 最大序号, 未出现的通道为 kNone
+};
@@ -1,5 +1,6 @@
 // ConfigReader.h
 #pragma once
+#include <algorithm>
 #include <string>
 #include <unordered_map>
 #include <fstream>
@@ -15,6 +16,18 @@ public:
         return (it != data_.end()) ? it->second : default_val;
     }
 
+    // 某一段下的全部 key = value
+    std::unordered_map<std::string, std::string> getSection(const std::string& section) const {
+        std::unordered_map<std::string, std::string> result;
+        const std::string prefix = section + ".";
+        for (const auto& [name, value] : data_) {
+            if (name.compare(0, prefix.size(), prefix) == 0) {
+                result.emplace(name.substr(prefix.size()), value);
+            }
+        }
+        return result;
+    }
+
     int getInt(const std::string& section, const std::string& key, int default_val = 0) const {
         std::string val = get(section, key);
         if (val.empty()) return default_val;
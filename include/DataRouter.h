@@ -1,35 +1,75 @@
 #pragma once
 #include "concurrentqueue/blockingconcurrentqueue.h"
 #include "OrderBook.h"
-#include "AsyncFileWriter.h"
+#include "OrderBookRegistry.h"
+#include "TickJournal.h"
 #include "DataStruct.h"
+#include "L2FrameDecoder.h"
+#include "SymbolTable.h"
+#include "PipelineConfig.h"
+#include "SpscRingBuffer.h"
+#include "ThreadConfig.h"
+#include "WaitStrategy.h"
 
 class DataRouter {
-public: 
+public:
     DataRouter(
-        std::unordered_map<std::string, std::unique_ptr<OrderBook>>& orderBooks_ref,
-        AsyncFileWriter& asyncFileWriter_ref
+        OrderBookRegistry& orderBooks_ref,
+        TickJournal* tickJournal_ptr,
+        const PipelineConfig& pipeline_config,
+        const ThreadRole& role
     );
     ~DataRouter();
 
     void stop();
-    void pushData(const DataMessage& data_message);
+    void pushData(DataMessage data_message);
 
 private:
-    void worker();
+    // 单路行情的完整解析管道: 输入队列 --> 分帧解析 --> 按 OrderBook 分组投递
+    // 逐笔委托与逐笔成交各一路, 各自独占一个线程, 一路突发不会拖慢另一路;
+    // 管道内状态只由本路线程访问, 无需加锁
+    struct Stream {
+        size_t index = 0; // streamIndex(), 同时作为 OrderBook 侧的通道号
+        DataMessage::MessageType type = DataMessage::MessageType::ORDER;
 
-    std::string order_buffer_; // 数据缓冲区, 用于存储拆包非完整数据
-    std::string trade_buffer_; // 数据缓冲区, 用于存储拆包非完整数据
+        L2FrameDecoder decoder; // 分帧器, 保存跨分片的非完整帧
+        std::vector<MarketEvent> events; // 单个分片解析结果, 复用容量
+        std::vector<std::vector<MarketEvent>> route_batches; // SymbolId -> 待批量投递的事件, 复用容量
+        std::vector<SymbolId> touched_symbols; // 当前分片中出现过的合约
+        std::vector<SymbolId> spilled_symbols; // SPSC 环形缓冲区已满, 仍有事件暂存的 OrderBook
+        TickJournalBatch journal_batch; // 当前分片的原始记录, 每个分片提交一次
+
+        // 输入队列, queue_type = spsc 时使用环形缓冲区, 生产者为对应的 L2TcpSubscriber 接收线程
+        moodycamel::BlockingConcurrentQueue<DataMessage> queue;
+        std::unique_ptr<SpscRingBuffer<DataMessage>> ring;
+        WaitStrategy waiter; // 两种队列共用其等待方式; moodycamel 队列只按其方式自旋, 挂起在队列自身上
+        std::vector<DataMessage> inbox; // 从环形缓冲区批量取出的消息
+
+        std::thread thread;
+    };
+
+    void worker(Stream& stream);
+    bool waitMessage(Stream& stream, DataMessage& data_message);
+    void handleMessage(Stream& stream, const DataMessage& data_message);
+    OrderBookBase* findOrderBook(Stream& stream, SymbolId symbol_id);
+    void deliver(Stream& stream, SymbolId symbol_id, OrderBookBase* book, const MarketEvent* events, size_t count);
+    void flushBatches(Stream& stream);
+    void retrySpilledBooks(Stream& stream);
+
+    // 有 OrderBook 暂存事件时, 解析线程空闲等待的最长时间, 到期补投一次
+    static constexpr std::chrono::microseconds kSpillRetryInterval{1000};
+
+    Stream streams_[kL2StreamCount];
+    size_t route_batch_size_; // 单次 enqueue_bulk 的最大事件数
+    ThreadRole role_;         // 解析线程的核心绑定与等待方式
 
     std::atomic<bool> running_;
-    std::thread worker_thread_;
-    moodycamel::BlockingConcurrentQueue<DataMessage> eventQueue_;
 
     // 外部传入对象
-    AsyncFileWriter& asyncFileWriter_ref_;
-    std::unordered_map<std::string, std::unique_ptr<OrderBook>>& orderBooks_ref_;
+    TickJournal* tickJournal_ptr_; // 为空时不落盘原始数据
+    OrderBookRegistry& orderBooks_ref_; // 按 SymbolId 无锁查找, 查到的指针一直有效
+
 
-    
 
 
-};
\ No newline at end of file
+};
@@ -3,8 +3,10 @@
 #include <string_view>
 #include <vector>
 #include <charconv>
-#include <variant>
+#include <cstdint>
+#include <type_traits>
 #include "Logger.h"
+#include "SymbolTable.h"
 
 inline int timeStrToInt(const std::string& time_str) {
     if (time_str.empty()) return -1;
@@ -115,53 +117,29 @@ inline long long svToLong(std::string_view sv) {
     return result;
 }
 
+// 逐笔委托, 定长 POD, 入队/缓存时可直接按字节拷贝
 struct L2Order {
     //数据原始字段
     int index;          // 推送序号
-    std::string symbol; // 合约代码
-    int time; // 时间
+    SymbolId symbol_id; // 合约代码, 解析时驻留进 SymbolTable
+    int timestamp;      // 时间戳，单位毫秒, 由原始时间 HHMMSSmmm 换算
     int num1; // 委托编号
     int price;          // 单位：0.0001 元（即 price / 10000.0 为真实价格）
     int volume;         // 股数
-    int type;           // 10 = 撤单, 1 = 市价, 2 = 限价, 3 = 本方最优
-    int side;           // 1 = buy, 2 = sell
     int num2; // 原始订单号, 仅上交所
     int num3;       // 逐笔数据序号, 仅上交所
-    int channel;    // 交易通道号
 
     // 以下为衍生字段
     int id; //无论是上交所还是深交所，统一使用这个字段
-    int timestamp; // 时间戳，单位毫秒
 
-    L2Order() = default;
-    // 构造函数：从 string_view 拷贝
-    L2Order(const std::vector<std::string_view>& fields) 
-        : index(svToInt(fields[0]))
-        , symbol(fields[1])
-        , time(svToInt(fields[4]))
-        , num1(svToInt(fields[5]))
-        , price(svToInt(fields[6]))
-        , volume(svToInt(fields[7]))
-        , type(svToInt(fields[8]))
-        , side(svToInt(fields[9]))
-        , num2(svToInt(fields[10]))
-        , num3(svToInt(fields[11]))
-        , channel(svToInt(fields[12]))
-    {
-        if (!symbol.empty() && symbol[0] == '6') {
-            // 上海票用num2
-            id = num2;
-        } else {
-            // 深圳票用num1
-            id = num1;
-        }
-        timestamp = timeIntToMs(time);
-    }
+    uint16_t channel;   // 交易通道号
+    uint8_t type;       // 10 = 撤单, 1 = 市价, 2 = 限价, 3 = 本方最优
+    uint8_t side;       // 1 = buy, 2 = sell
 
+    L2Order() = default;
     void info() const {
-        LOG_INFO("L2Order", "股票代码:{}, 时间:{}, 价格:{}, 数量:{}, 委托类型:{}, 方向:{}, 委托编号:{}, 时间戳:{}",
-        symbol,
-        time,
+        LOG_INFO("L2Order", "股票代码:{}, 价格:{}, 数量:{}, 委托类型:{}, 方向:{}, 委托编号:{}, 时间戳:{}",
+        SymbolTable::instance().name(symbol_id),
         price,
         volume,
         type,
@@ -173,45 +151,26 @@ struct L2Order {
 
 };
 
+// 逐笔成交, 定长 POD, 入队/缓存时可直接按字节拷贝
 struct L2Trade {
     // 数据原始字段
+    long long amount;         // 成交金额, 因为价格一般是一万倍表示, 所以金额可能很大, 用 long long 存储
     int index;          // 推送序号
-    std::string symbol; // 合约代码
-    int time; // 时间
+    SymbolId symbol_id; // 合约代码, 解析时驻留进 SymbolTable
+    int timestamp;      // 时间戳，单位毫秒, 由原始时间 HHMMSSmmm 换算
     int num1; // 成交编号
     int price;          // 单位：0.0001 元（即 price / 10000.0 为真实价格）
     int volume;         // 股数
-    long long amount;         // 成交金额, 因为价格一般是一万倍表示, 所以金额可能很大, 用 long long 存储
-    int side;           // 1 = buy, 2 = sell
-    int type;           // 0 = 成交, 1 = 撤单 
     int sell_id;        // 卖方委托号
     int buy_id;         // 买方委托号
-
-    // 以下为衍生字段
-    int timestamp; // 时间戳，单位毫秒
+    uint16_t channel;   // 交易通道号
+    uint8_t side;       // 1 = buy, 2 = sell
+    uint8_t type;       // 0 = 成交, 1 = 撤单 
 
     L2Trade() = default;
-    // 构造函数：从 string_view 拷贝
-    L2Trade(const std::vector<std::string_view>& fields) 
-        : index(svToInt(fields[0]))
-        , symbol(fields[1])
-        , time(svToInt(fields[4]))
-        , num1(svToInt(fields[5]))
-        , price(svToInt(fields[6]))
-        , volume(svToInt(fields[7]))
-        , amount(svToLong(fields[8]))
-        , side(svToInt(fields[9]))
-        , type(svToInt(fields[10]))
-        , sell_id(svToInt(fields[12]))
-        , buy_id(svToInt(fields[13]))
-    {
-        timestamp = timeIntToMs(time);
-    }
-
     void info() const {
-        LOG_INFO("L2Trade", "股票代码:{}, 时间:{}, 价格:{}, 成交量:{}, 成交金额:{}, 方向:{}, 成交类型:{}, 卖方委托号:{}, 买方委托号:{}, 时间戳:{}",
-        symbol,
-        time,
+        LOG_INFO("L2Trade", "股票代码:{}, 价格:{}, 成交量:{}, 成交金额:{}, 方向:{}, 成交类型:{}, 卖方委托号:{}, 买方委托号:{}, 时间戳:{}",
+        SymbolTable::instance().name(symbol_id),
         price,
         volume,
         amount,
@@ -226,6 +185,10 @@ struct L2Trade {
 
 };
 
+static_assert(std::is_trivially_copyable_v<L2Order> && sizeof(L2Order) <= 48, "L2Order 需保持定长 POD");
+static_assert(std::is_trivially_copyable_v<L2Trade> && sizeof(L2Trade) <= 48, "L2Trade 需保持定长 POD");
+
+// 快照行情, 字段多且含字符串, 不走逐笔事件队列
 struct MarketSpot {
     int index;          // 推送序号
     std::string symbol; // 合约代码
@@ -292,33 +255,46 @@ struct MarketSpot {
     int transaction_sell_cancel_volume; // 卖出撤单量 *仅限上交所
 };
 
+// 逐笔事件: 委托/成交的带标签联合体, 整体可平凡拷贝, 不超过一个缓存行
 struct MarketEvent {
-    enum class EventType { ORDER, TRADE, MARKET_SPOT } type;
+    enum class EventType : uint8_t { ORDER, TRADE } type;
 
-    std::variant< L2Order, L2Trade, MarketSpot > data;
+    union {
+        L2Order order; // type == ORDER 时有效
+        L2Trade trade; // type == TRADE 时有效
+    };
 
-    MarketEvent() = default;
-    MarketEvent(const L2Order& o) : type(EventType::ORDER), data(o) {}
-    MarketEvent(const L2Trade& t) : type(EventType::TRADE), data(t) {}
-    MarketEvent(const MarketSpot& m) : type(EventType::MARKET_SPOT), data(m) {}
+    MarketEvent() : type(EventType::ORDER), order() {}
+    MarketEvent(const L2Order& o) : type(EventType::ORDER), order(o) {}
+    MarketEvent(const L2Trade& t) : type(EventType::TRADE), trade(t) {}
 
 };
 
+static_assert(std::is_trivially_copyable_v<MarketEvent> && sizeof(MarketEvent) <= 64, "MarketEvent 需保持定长 POD");
+
 struct DataMessage {
     enum class MessageType { ORDER, TRADE, MARKET_SPOT };
 
     std::string data_;
     MessageType type_;
+    int64_t recv_time_us_ = 0; // 接收时间, 自 1970-01-01 起的微秒
 
     DataMessage() = default;
-    DataMessage(std::string data, MessageType type) 
-        : data_(std::move(data)), type_(type) {}
+    DataMessage(std::string data, MessageType type, int64_t recv_time_us = 0) 
+        : data_(std::move(data)), type_(type), recv_time_us_(recv_time_us) {}
 };
 
-inline const std::string &getSymbol(const MarketEvent &evt) {
+// 逐笔行情输入流数: 逐笔委托 / 逐笔成交各一路
+constexpr size_t kL2StreamCount = 2;
+
+inline size_t streamIndex(DataMessage::MessageType type) {
+    return type == DataMessage::MessageType::TRADE ? 1 : 0;
+}
+
+inline SymbolId getSymbolId(const MarketEvent &evt) {
   if (evt.type == MarketEvent::EventType::ORDER) {
-    return std::get<L2Order>(evt.data).symbol;
+    return evt.order.symbol_id;
   } else {
-    return std::get<L2Trade>(evt.data).symbol;
+    return evt.trade.symbol_id;
   }
 }
\ No newline at end of file
@@ -12,8 +12,13 @@
 #include "L2HttpDownloader.h"
 #include "ReceiveServer.h"
 #include "OrderBook.h"
+#include "OrderBookRegistry.h"
 #include "AutoSaveJsonMap.hpp"
-#include "AsyncFileWriter.h"
+#include "TickJournal.h"
+#include "PipelineConfig.h"
+#include "PriceBandConfig.h"
+#include "ShardWorkerPool.h"
+#include "ThreadConfig.h"
 
 class Executor {
 public:
@@ -43,10 +48,13 @@ private:
     std::string username_;
     std::string password_;
     int vol_flag_;
+    PipelineConfig pipeline_config_;
+    PriceBandConfig price_band_config_;
+    ThreadConfig thread_config_;
 
-    std::unique_ptr<AsyncFileWriter> asyncFileWriter_;
+    std::unique_ptr<TickJournal> tickJournal_;
 
-    std::unique_ptr<std::unordered_map<std::string, std::unique_ptr<OrderBook>>> orderBooks_;
+    std::unique_ptr<OrderBookRegistry> orderBooks_;
     std::unique_ptr<AutoSaveJsonMap<std::string, std::vector<int>>> cancelMonitorInfo_;
     std::unique_ptr<AutoSaveJsonMap<std::string, std::unordered_map<int, int>>> sellMonitorInfo_;
     std::unique_ptr<AutoSaveJsonMap<std::string, std::vector<int>>> queueMonitorInfo_;
@@ -61,6 +69,7 @@ private:
     std::unique_ptr<SendServer> queueSendServer_;
     std::unique_ptr<ReceiveServer> recvServer_;
     std::unique_ptr<DataRouter> dataRouter_;
+    std::unique_ptr<ShardWorkerPool> workerPool_; // 须先于 orderBooks_ 析构
 
     // 重启标志物
     mutable std::atomic<bool> reset_requested_by_executor_{false};
@@ -0,0 +1,85 @@
+// FenwickTree.h
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+// 树状数组, 下标从 0 开始
+// 单点增量、前缀和与按前缀和查找下标均为 O(log n), reset 从完整数组 O(n) 建树
+template<typename T>
+class FenwickTree {
+public:
+    FenwickTree() = default;
+    explicit FenwickTree(size_t size) : tree_(size + 1, T()) {}
+
+    size_t size() const { return tree_.empty() ? 0 : tree_.size() - 1; }
+
+    // 按 values 重建, 大小变为 values.size()
+    template<typename Values, typename Get>
+    void reset(const Values& values, Get&& get) {
+        tree_.assign(values.size() + 1, T());
+        for (size_t i = 1; i < tree_.size(); ++i) {
+            tree_[i] += get(values[i - 1]);
+            size_t parent = i + (i & (~i + 1));
+            if (parent < tree_.size()) {
+                tree_[parent] += tree_[i];
+            }
+        }
+    }
+
+    // 末尾追加一个元素, O(log n)
+    void push_back(T value) {
+        if (tree_.empty()) {
+            tree_.push_back(T());
+        }
+
+        // 新节点覆盖 (i - lowbit(i), i], 除自身外的部分由已有节点拼出
+        size_t i = tree_.size();
+        size_t low = i - (i & (~i + 1));
+        T sum = value;
+        for (size_t j = i - 1; j > low; j -= j & (~j + 1)) {
+            sum += tree_[j];
+        }
+        tree_.push_back(sum);
+    }
+
+    void clear() { tree_.clear(); }
+
+    void add(size_t index, T delta) {
+        for (size_t i = index + 1; i < tree_.size(); i += i & (~i + 1)) {
+            tree_[i] += delta;
+        }
+    }
+
+    // [0, index] 之和, index 超出范围时按最后一个元素计
+    T prefixSum(size_t index) const {
+        T sum = T();
+        if (tree_.empty()) {
+            return sum;
+        }
+        for (size_t i = std::min(index + 1, tree_.size() - 1); i > 0; i -= i & (~i + 1)) {
+            sum += tree_[i];
+        }
+        return sum;
+    }
+
+    // 元素均非负时, 返回前缀和首次 >= target 的下标, 不存在时返回 size()
+    size_t lowerBound(T target) const {
+        size_t step = 1;
+        while (step * 2 < tree_.size()) {
+            step *= 2;
+        }
+
+        size_t pos = 0;
+        for (; step > 0; step >>= 1) {
+            if (pos + step < tree_.size() && tree_[pos + step] < target) {
+                pos += step;
+                target -= tree_[pos];
+            }
+        }
+        return pos;
+    }
+
+private:
+    std::vector<T> tree_;
+};
@@ -0,0 +1,162 @@
+// L2FrameDecoder.h
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "Logger.h"
+#include "L2Scanner.h"
+
+// 逐笔行情 TCP 流式分帧器
+// 协议格式: <rec#rec#...><rec...>, 帧内记录以 '#' 分隔
+// 数据记录以推送序号(数字)开头, HeartBeat / DY2 / Login / Order / Tran 等控制帧以字母开头,
+// 因此只看记录首字节即可在同一遍扫描中完成分类, 无需对每条记录做多次 find
+//
+// 解码状态可跨 recv 分片恢复: 完整记录直接在输入数据上以 string_view 交付,
+// 只有被分片切断的那条记录会被拷贝进复用缓冲区 pending_, 下一个分片到达时只需在新数据里找记录结束符
+// 每条数据记录连同其字段偏移以 l2scan::L2RecordView 交付, 解析端无需再次切分
+class L2FrameDecoder {
+public:
+    struct Stats {
+        uint64_t frames = 0;          // 完整帧数
+        uint64_t data_records = 0;    // 交付的数据记录数
+        uint64_t control_frames = 0;  // 控制帧数
+        uint64_t dropped_bytes = 0;   // 帧外或超长而被丢弃的字节数
+    };
+
+    // 单条未结束记录的最大缓存长度, 超过视为脏数据丢弃
+    static constexpr size_t kMaxPendingBytes = 1 << 20;
+
+    // 输入一个 recv 分片, 对其中每条完整数据记录调用 on_record(const l2scan::L2RecordView&)
+    // 交付的记录只在回调内有效
+    template<typename OnRecord>
+    void feed(std::string_view chunk, OnRecord&& on_record) {
+        if (state_ == State::IN_RECORD) {
+            // 上一个分片停在记录中间, pending_ 中是该记录已收到的部分, 只需在新数据里找记录结束符
+            size_t end = chunk.find_first_of("#>");
+            if (end == std::string_view::npos) {
+                if (pending_.size() + chunk.size() > kMaxPendingBytes) {
+                    LOG_WARN("L2Parser", "未结束记录超过 {} 字节, 丢弃缓冲区数据", kMaxPendingBytes);
+                    stats_.dropped_bytes += pending_.size() + chunk.size();
+                    pending_.clear();
+                    state_ = State::SKIP_FRAME;
+                    return;
+                }
+                pending_.append(chunk.data(), chunk.size());
+                return;
+            }
+
+            pending_.append(chunk.data(), end + 1);
+            decode(pending_, on_record);
+            pending_.clear();
+            chunk.remove_prefix(end + 1);
+        }
+
+        size_t consumed = decode(chunk, on_record);
+        if (consumed < chunk.size()) {
+            pending_.assign(chunk.data() + consumed, chunk.size() - consumed);
+        }
+    }
+
+    size_t pendingBytes() const { return pending_.size(); }
+    const Stats& stats() const { return stats_; }
+
+    void reset() {
+        state_ = State::OUTSIDE;
+        pending_.clear();
+        stats_ = Stats{};
+    }
+
+private:
+    enum class State { OUTSIDE, IN_RECORD, SKIP_FRAME };
+
+    // 从 state_ 开始解码 input, 返回已消费的字节数; 若停在记录中间, 未消费部分即该记录已收到的内容
+    // 由 l2scan 分隔符位图驱动的状态机, 一遍扫描同时完成分帧, 记录切分与字段切分
+    template<typename OnRecord>
+    size_t decode(std::string_view input, OnRecord& on_record) {
+        size_t consumed = 0;       // 已处理完的位置
+        size_t record_start = 0;
+
+        if (state_ == State::IN_RECORD) {
+            splitter_.begin(input.data(), record_start);
+        }
+
+        auto finish_record = [&](size_t end) {
+            if (end == record_start) {
+                return; // 空记录, 如 "##" 或结尾的 '#'
+            }
+            if (!isDataRecord(input[record_start])) {
+                // 控制帧, 帧内剩余内容一并忽略
+                ++stats_.control_frames;
+                state_ = State::SKIP_FRAME;
+                return;
+            }
+            ++stats_.data_records;
+            on_record(splitter_.finish(end));
+        };
+
+        l2scan::forEachDelimiter(input, [&](size_t pos, char c) {
+            switch (state_) {
+                case State::OUTSIDE:
+                    if (c == '<') {
+                        stats_.dropped_bytes += pos - consumed;
+                        record_start = pos + 1;
+                        consumed = record_start;
+                        splitter_.begin(input.data(), record_start);
+                        state_ = State::IN_RECORD;
+                    }
+                    break;
+
+                case State::IN_RECORD:
+                    if (c == ',') {
+                        splitter_.onComma(pos);
+                    } else if (c == '#') {
+                        finish_record(pos);
+                        consumed = pos + 1;
+                        if (state_ == State::IN_RECORD) {
+                            record_start = consumed;
+                            splitter_.begin(input.data(), record_start);
+                        }
+                    } else if (c == '>') {
+                        finish_record(pos);
+                        ++stats_.frames;
+                        consumed = pos + 1;
+                        state_ = State::OUTSIDE;
+                    }
+                    break;
+
+                case State::SKIP_FRAME:
+                    if (c == '>') {
+                        ++stats_.frames;
+                        state_ = State::OUTSIDE;
+                    }
+                    consumed = pos + 1;
+                    break;
+            }
+        });
+
+        switch (state_) {
+            case State::IN_RECORD:
+                return consumed;
+            case State::SKIP_FRAME:
+                return input.size();
+            case State::OUTSIDE:
+                break;
+        }
+
+        if (consumed < input.size()) {
+            stats_.dropped_bytes += input.size() - consumed;
+            LOG_WARN("L2Parser", "无法找到 '<', 丢弃帧外数据: {}", input.substr(consumed));
+        }
+        return input.size();
+    }
+
+    static bool isDataRecord(char first) {
+        return first >= '0' && first <= '9';
+    }
+
+    State state_ = State::OUTSIDE;
+    std::string pending_; // 跨分片的未结束记录, 复用容量
+    l2scan::L2FieldSplitter splitter_;
+    Stats stats_;
+};
@@ -5,6 +5,7 @@
 #include <mutex>
 
 #include "OrderBook.h"
+#include "OrderBookRegistry.h"
 
 class L2HttpDownloader { 
 public:
@@ -12,7 +13,7 @@ public:
         const std::string& base_url,
         const std::string& username,
         const std::string& password,
-        std::unordered_map<std::string, std::unique_ptr<OrderBook>>& orderBooks_ref
+        OrderBookRegistry& orderBooks_ref
     );
 
     ~L2HttpDownloader();
@@ -36,7 +37,7 @@ private:
     std::string password_;
     std::string cookie_;
 
-    std::unordered_map<std::string, std::unique_ptr<OrderBook>>& orderBooks_ref_;
+    OrderBookRegistry& orderBooks_ref_;
 
     mutable std::mutex mtx_;
     std::vector<std::future<void>> pending_tasks_;
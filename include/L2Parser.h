@@ -8,7 +8,10 @@
 #include "Logger.h"
 #include "DataStruct.h"
 #include "AutoSaveJsonMap.hpp"
-#include "AsyncFileWriter.h"
+#include "TickJournal.h"
+#include "L2FrameDecoder.h"
+#include "L2Schema.h"
+#include "SymbolTable.h"
 
 
 // 辅助函数：按 ',' 分割 string_view（不支持转义）
@@ -28,133 +31,36 @@ inline std::vector<std::string_view> splitByComma(std::string_view str) {
     return tokens;
 }
 
-template<typename T>
-struct L2FieldCount {
-    static constexpr size_t field_num = 0; // 默认值
-};
-
-template<>
-struct L2FieldCount<L2Order> {
-    static constexpr size_t field_num = 13; // 14 个字段
-};
-
-template<>
-struct L2FieldCount<L2Trade> {
-    static constexpr size_t field_num = 14; // 14 个字段
-};
-
-
-inline std::vector<MarketEvent> parseL2Data(
-    std::string& data, DataMessage::MessageType type, 
-    std::string& buffer_, AsyncFileWriter& asyncFileWriter_ref) {
-
-    constexpr size_t ORDER_FIELDS  = L2FieldCount<L2Order>::field_num;
-    constexpr size_t TRADE_FIELDS  = L2FieldCount<L2Trade>::field_num;
-
-    std::vector<MarketEvent> event_list;
-    size_t pos = 0;
-    
-    buffer_.append(data);
-    std::string_view buffer_view = buffer_;
-
-    while (pos < buffer_.size()) {
-        // 查找 '<'
-        size_t open = buffer_view.find('<', pos);
-        if (open == std::string_view::npos) {
-            buffer_.clear(); // 没有找到 '<'，清空缓冲区
-            buffer_.append(data); // 保留未处理数据
-            
-            LOG_WARN("L2Parser", "无法找到 '<', 丢弃缺失数据, 保留新缓冲区数据: {}", buffer_);
-            return event_list;
-        }
-
-        // 查找 '>'
-        size_t close = buffer_view.find('>', open);
-        if (close == std::string_view::npos) {
-            buffer_ = buffer_.substr(open); // 保留不完整部分
-
-            LOG_WARN("L2Parser", "无法找到 '>', 保留不完整数据到缓冲区: {}", buffer_);
-            return event_list;
-        }
-        
-        // 提取整个 <...> 内容
-        std::string_view full_record = buffer_view.substr(open + 1, close - open - 1);
-        
-        // 按 '#' 分割为多个订单
-        size_t start = 0;
-        size_t end = 0;
-
-        auto splitfunc = [&](std::string_view order_part){
-            if (!order_part.empty()) {
-                auto fields = splitByComma(order_part);
-                if (type == DataMessage::MessageType::ORDER){
-                    if (fields.size() == ORDER_FIELDS) {
-                        MarketEvent event{L2Order(fields)};
-                        event_list.push_back(event);
-
-                        std::string symbol = std::get<L2Order>(event.data).symbol;
-                        std::string path = "data/" + symbol + "_order_tcp.txt";
-                        asyncFileWriter_ref.write_async(path, std::string(order_part));
-
-                    } else {
-                        LOG_WARN("L2Parser", "buffer_:{}, open:{}, length:{}", buffer_, open, close-open-1);
-                        LOG_WARN("L2Parser", "order字段数不匹配, data:{}", full_record);
-                    }
-                } else if (type == DataMessage::MessageType::TRADE){
-                    if (fields.size() == TRADE_FIELDS) {
-                        MarketEvent event{L2Trade(fields)};
-                        event_list.push_back(event);
-
-                        std::string symbol = std::get<L2Trade>(event.data).symbol;
-                        std::string path = "data/" + symbol + "_trade_tcp.txt";
-                        asyncFileWriter_ref.write_async(path, std::string(order_part));
-                    } else {
-                        LOG_WARN("L2Parser", "buffer_:{}, open:{}, length:{}", buffer_, open, close-open-1);
-                        LOG_WARN("L2Parser", "trade字段数不匹配, data:{}", full_record);
-                    }
-                }
+// 解析一个 TCP 分片: 由 decoder 完成分帧, 解析出的事件追加到 event_list,
+// 原始记录追加进 journal_batch(为空指针时不落盘), 由调用方按分片提交给 TickJournal
+inline void parseL2Data(
+    std::string_view data, DataMessage::MessageType type, int64_t recv_time_us,
+    L2FrameDecoder& decoder, TickJournalBatch* journal_batch,
+    std::vector<MarketEvent>& event_list) {
+
+    const uint8_t stream = static_cast<uint8_t>(streamIndex(type));
+
+    decoder.feed(data, [&](const l2scan::L2RecordView& record) {
+        if (type == DataMessage::MessageType::ORDER){
+            // 直接解析进队尾事件, 字段数不匹配时撤销
+            L2Order& order = event_list.emplace_back(L2Order{}).order;
+            if (parseL2Record<L2Order, TcpLayout>(record, order) && order.symbol_id != kInvalidSymbolId) {
+                if (journal_batch) journal_batch->append(stream, order.symbol_id, recv_time_us, record.text);
+            } else {
+                event_list.pop_back();
+                LOG_WARN("L2Parser", "order字段数不匹配, data:{}", record.text);
             }
-        };
-
-        while (true) {
-            end = full_record.find("#", start);
-            if (end == std::string_view::npos) {
-                if (start >= full_record.size()) {
-                    break;
-                }
-
-                std::string_view order_part = full_record.substr(start);
-
-                if (order_part.find("HeartBeat") != std::string_view::npos ||
-                    order_part.find("DY2") != std::string_view::npos ||
-                    order_part.find("Order") != std::string_view::npos ||
-                    order_part.find("Tran") != std::string_view::npos ||
-                    order_part.find("Login") != std::string_view::npos) {
-                    break;
-                }
-
-                splitfunc(order_part);
-                break;
+        } else if (type == DataMessage::MessageType::TRADE){
+            // 直接解析进队尾事件, 字段数不匹配时撤销
+            L2Trade& trade = event_list.emplace_back(L2Trade{}).trade;
+            if (parseL2Record<L2Trade, TcpLayout>(record, trade) && trade.symbol_id != kInvalidSymbolId) {
+                if (journal_batch) journal_batch->append(stream, trade.symbol_id, recv_time_us, record.text);
             } else {
-                std::string_view order_part = full_record.substr(start, end - start);
-
-                if (order_part.find("HeartBeat") != std::string_view::npos ||
-                    order_part.find("DY2") != std::string_view::npos ||
-                    order_part.find("Order") != std::string_view::npos ||
-                    order_part.find("Tran") != std::string_view::npos ||
-                    order_part.find("Login") != std::string_view::npos) {
-                    break;
-                }
-
-                splitfunc(order_part);
-                start = end + 1;  // 跳过 '#'
+                event_list.pop_back();
+                LOG_WARN("L2Parser", "trade字段数不匹配, data:{}", record.text);
             }
         }
-
-        pos = close + 1; // 移动到 '>' 之后
-    }
-    buffer_.clear(); // 全部处理完，清空缓冲区
-    return event_list;
+    });
 }
 
 inline std::string formatCancelMessage(
@@ -0,0 +1,161 @@
+// L2Scanner.h
+#pragma once
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// L2 文本协议分隔符扫描层
+// 以 64 字节为一块, 用向量指令一次生成整块的分隔符位图 (',' '#' '<' '>' '\n'),
+// 再按位遍历得到每个分隔符的偏移. 指令集在运行时按 CPU 能力选择: AVX2 > SSE4.2 > 标量
+namespace l2scan {
+
+enum class IsaLevel : int { SCALAR = 0, SSE42 = 1, AVX2 = 2 };
+
+constexpr size_t kBlockBytes = 64;
+
+// 单条记录最多保存的字段数, 超出部分只计数不保存
+constexpr size_t kMaxRecordFields = 80;
+
+// CPU 支持的最高指令集级别
+IsaLevel detectIsaLevel();
+
+// 当前使用的指令集级别
+IsaLevel activeIsaLevel();
+
+// 强制切换指令集级别(用于基准测试与排查), 超出 CPU 能力时返回 false
+bool setIsaLevel(IsaLevel level);
+
+const char* isaLevelName(IsaLevel level);
+
+// 为 block_count 个完整的 64 字节块生成分隔符位图, masks[i] 的第 j 位对应 data[i * 64 + j]
+void buildDelimiterMasks(const char* data, size_t block_count, uint64_t* masks);
+
+inline int countTrailingZeros(uint64_t mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, mask);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(mask);
+#endif
+}
+
+// 按顺序对 data 中每个分隔符调用 fn(size_t offset, char delimiter)
+template<typename Fn>
+void forEachDelimiter(std::string_view data, Fn&& fn) {
+    constexpr size_t kBatchBlocks = 64; // 每批 4KB, 位图放在栈上
+
+    uint64_t masks[kBatchBlocks];
+    const char* base = data.data();
+    const size_t full_blocks = data.size() / kBlockBytes;
+
+    size_t block = 0;
+    while (block < full_blocks) {
+        size_t batch = full_blocks - block;
+        if (batch > kBatchBlocks) batch = kBatchBlocks;
+
+        buildDelimiterMasks(base + block * kBlockBytes, batch, masks);
+
+        for (size_t i = 0; i < batch; ++i) {
+            uint64_t mask = masks[i];
+            const size_t block_offset = (block + i) * kBlockBytes;
+            while (mask != 0) {
+                size_t offset = block_offset + countTrailingZeros(mask);
+                fn(offset, base[offset]);
+                mask &= mask - 1;
+            }
+        }
+        block += batch;
+    }
+
+    // 尾部不足 64 字节, 拷贝到补零的块中扫描
+    const size_t tail_offset = full_blocks * kBlockBytes;
+    const size_t tail_size = data.size() - tail_offset;
+    if (tail_size > 0) {
+        alignas(32) char tail[kBlockBytes] = {0};
+        std::memcpy(tail, base + tail_offset, tail_size);
+
+        uint64_t mask = 0;
+        buildDelimiterMasks(tail, 1, &mask);
+        while (mask != 0) {
+            size_t offset = tail_offset + countTrailingZeros(mask);
+            fn(offset, base[offset]);
+            mask &= mask - 1;
+        }
+    }
+}
+
+// 一条记录及其字段偏移, 字段为空(连续逗号或末尾逗号)时跳过, 与 splitByComma 语义一致
+struct L2RecordView {
+    std::string_view text;
+    size_t field_count = 0;
+    std::array<std::string_view, kMaxRecordFields> fields;
+};
+
+// 由分隔符事件驱动的字段切分器, 调用方保证 begin/addField/finish 按偏移递增调用
+class L2FieldSplitter {
+public:
+    void begin(const char* base, size_t start) {
+        base_ = base;
+        record_start_ = start;
+        field_start_ = start;
+        record_.field_count = 0;
+    }
+
+    void onComma(size_t pos) {
+        addField(pos);
+        field_start_ = pos + 1;
+    }
+
+    const L2RecordView& finish(size_t end) {
+        addField(end);
+        record_.text = std::string_view(base_ + record_start_, end - record_start_);
+        return record_;
+    }
+
+private:
+    void addField(size_t end) {
+        if (end > field_start_) {
+            if (record_.field_count < kMaxRecordFields) {
+                record_.fields[record_.field_count] = std::string_view(base_ + field_start_, end - field_start_);
+            }
+            ++record_.field_count;
+        }
+    }
+
+    const char* base_ = nullptr;
+    size_t record_start_ = 0;
+    size_t field_start_ = 0;
+    L2RecordView record_;
+};
+
+// 按行切分 CSV 数据, 对每一行调用 on_record(const L2RecordView&), 空行跳过
+template<typename OnRecord>
+void forEachCsvRecord(std::string_view data, OnRecord&& on_record) {
+    L2FieldSplitter splitter;
+    size_t line_start = 0;
+    splitter.begin(data.data(), 0);
+
+    forEachDelimiter(data, [&](size_t pos, char c) {
+        if (c == ',') {
+            splitter.onComma(pos);
+        } else if (c == '\n') {
+            if (pos > line_start) {
+                on_record(splitter.finish(pos));
+            }
+            line_start = pos + 1;
+            splitter.begin(data.data(), line_start);
+        }
+    });
+
+    if (line_start < data.size()) {
+        on_record(splitter.finish(data.size()));
+    }
+}
+
+} // namespace l2scan
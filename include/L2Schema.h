@@ -0,0 +1,154 @@
+// L2Schema.h
+#pragma once
+#include <cstddef>
+#include <string_view>
+#include <type_traits>
+
+#include "DataStruct.h"
+#include "L2Scanner.h"
+#include "MarketPolicy.h"
+#include "SwarDecoder.h"
+#include "SymbolTable.h"
+
+// 逐笔数据字段布局的编译期描述
+// 每种记录格式(TCP 推送 / HTTP 历史下载)只在这里描述一次: 字段总数 + 每个成员取自第几个字段,
+// 解析器由描述在编译期展开, 直接写入目标结构体, 不经过中间容器, 每条记录零分配
+
+struct TcpLayout {};   // TCP 实时推送格式
+struct HttpLayout {};  // HTTP 历史下载格式, 比 TCP 多出末尾一列
+
+// 整数字段, 目标成员可以是 uint8_t / uint16_t 等窄类型
+template<size_t Index, auto Member>
+struct L2IntField {
+    static constexpr size_t index = Index;
+
+    template<typename T>
+    static void apply(std::string_view sv, T& out) {
+        using Value = std::remove_reference_t<decltype(out.*Member)>;
+        out.*Member = static_cast<Value>(swarSvToInt(sv));
+    }
+};
+
+// 长整数字段
+template<size_t Index, auto Member>
+struct L2LongField {
+    static constexpr size_t index = Index;
+
+    template<typename T>
+    static void apply(std::string_view sv, T& out) {
+        out.*Member = swarSvToLong(sv);
+    }
+};
+
+// 合约代码字段, 驻留为 SymbolId, 事件中不再保存字符串
+template<size_t Index, auto Member>
+struct L2SymbolField {
+    static constexpr size_t index = Index;
+
+    template<typename T>
+    static void apply(std::string_view sv, T& out) {
+        out.*Member = SymbolTable::instance().intern(sv);
+    }
+};
+
+// 时间字段 HHMMSSmmm, 只保留换算后的毫秒时间戳
+template<size_t Index, auto TimestampMember>
+struct L2TimeField {
+    static constexpr size_t index = Index;
+
+    template<typename T>
+    static void apply(std::string_view sv, T& out) {
+        int time;
+        swarSvToTime(sv, time, out.*TimestampMember);
+    }
+};
+
+template<typename... Fields>
+struct L2FieldList {};
+
+// 主模板不定义: 新的记录格式(如后续接入的 MarketSpot 快照)需在此增加特化后才能解析
+template<typename T, typename Layout>
+struct L2Schema;
+
+template<>
+struct L2Schema<L2Order, TcpLayout> {
+    static constexpr size_t field_num = 13;
+
+    using fields = L2FieldList<
+        L2IntField<0, &L2Order::index>,
+        L2SymbolField<1, &L2Order::symbol_id>,
+        L2TimeField<4, &L2Order::timestamp>,
+        L2IntField<5, &L2Order::num1>,
+        L2IntField<6, &L2Order::price>,
+        L2IntField<7, &L2Order::volume>,
+        L2IntField<8, &L2Order::type>,
+        L2IntField<9, &L2Order::side>,
+        L2IntField<10, &L2Order::num2>,
+        L2IntField<11, &L2Order::num3>,
+        L2IntField<12, &L2Order::channel>
+    >;
+
+    static void finalize(L2Order& order) {
+        // 上海票用num2, 深圳票用num1, 市场判断与 OrderBook<Policy> 的选择一致
+        order.id = isSseSymbol(SymbolTable::instance().name(order.symbol_id)) ? order.num2 : order.num1;
+    }
+};
+
+template<>
+struct L2Schema<L2Order, HttpLayout> : L2Schema<L2Order, TcpLayout> {
+    static constexpr size_t field_num = 14;
+};
+
+template<>
+struct L2Schema<L2Trade, TcpLayout> {
+    static constexpr size_t field_num = 14;
+
+    using fields = L2FieldList<
+        L2IntField<0, &L2Trade::index>,
+        L2SymbolField<1, &L2Trade::symbol_id>,
+        L2TimeField<4, &L2Trade::timestamp>,
+        L2IntField<5, &L2Trade::num1>,
+        L2IntField<6, &L2Trade::price>,
+        L2IntField<7, &L2Trade::volume>,
+        L2LongField<8, &L2Trade::amount>,
+        L2IntField<9, &L2Trade::side>,
+        L2IntField<10, &L2Trade::type>,
+        L2IntField<11, &L2Trade::channel>,
+        L2IntField<12, &L2Trade::sell_id>,
+        L2IntField<13, &L2Trade::buy_id>
+    >;
+
+    static void finalize(L2Trade&) {}
+};
+
+template<>
+struct L2Schema<L2Trade, HttpLayout> : L2Schema<L2Trade, TcpLayout> {
+    static constexpr size_t field_num = 15;
+};
+
+// 各格式的字段总数
+template<typename T, typename Layout = TcpLayout>
+struct L2FieldCount {
+    static constexpr size_t field_num = L2Schema<T, Layout>::field_num;
+};
+
+template<typename Schema, typename T, typename... Fields>
+inline void applyL2Fields(const std::string_view* fields, T& out, L2FieldList<Fields...>) {
+    static_assert(((Fields::index < Schema::field_num) && ...), "字段下标超出记录字段数");
+    (Fields::apply(fields[Fields::index], out), ...);
+}
+
+// 按 Layout 描述把一条记录直接解析进 out, 字段数不匹配时返回 false 且不修改 out
+template<typename T, typename Layout>
+inline bool parseL2Record(const l2scan::L2RecordView& record, T& out) {
+    using Schema = L2Schema<T, Layout>;
+    static_assert(Schema::field_num <= l2scan::kMaxRecordFields, "记录字段数超过 L2RecordView 容量");
+
+    if (record.field_count != Schema::field_num) {
+        return false;
+    }
+
+    applyL2Fields<Schema>(record.fields.data(), out, typename Schema::fields{});
+    Schema::finalize(out);
+    return true;
+}
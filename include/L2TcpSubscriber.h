@@ -7,6 +7,7 @@
 
 #include "DataRouter.h"
 #include "DataStruct.h"
+#include "ThreadConfig.h"
 
 class L2TcpSubscriber {
 public:
@@ -16,7 +17,8 @@ public:
         const std::string& username,
         const std::string& password,
         DataMessage::MessageType type,
-        DataRouter& dataRouter_ref
+        DataRouter& dataRouter_ref,
+        const ThreadRole& recv_role = ThreadRole{}
     );
 
     ~L2TcpSubscriber();
@@ -59,6 +61,7 @@ private:
     std::string password_;
     DataMessage::MessageType type_;
     DataRouter& dataRouter_ref_;
+    ThreadRole recv_role_; // 接收线程的核心绑定, 逐笔委托/逐笔成交按 streamIndex() 各取一个核心
 
     std::atomic<bool> running_;
     SOCKET sock_;
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <vector>
+
 #include <spdlog/spdlog.h>
 
-bool init_log_system(const char* filename = "logs/app.log");
+// log_cores 为 spdlog 后台线程绑定的核心, 空为不绑定
+bool init_log_system(const char* filename = "logs/app.log", const std::vector<int>& log_cores = {});
 
 // 获取模块的日志器
 std::shared_ptr<class spdlog::logger> get_module_logger(const char* module_name);
@@ -0,0 +1,43 @@
+// MarketPolicy.h
+#pragma once
+#include <string_view>
+
+#include "DataStruct.h"
+
+// 交易所逐笔数据规则, 作为 OrderBook 模板参数, 市场差异在编译期确定
+
+// 上交所:
+//   逐笔委托 --> 限价2 入簿, 撤单10 在逐笔委托中, 市价1/本方最优3 价格未知不入簿
+//   逐笔成交 --> 只有成交, 主动成交一方的委托量不会出现在订单簿中
+struct SsePolicy {
+    static constexpr const char* kMarket = "SH";
+    static constexpr bool kCancelInOrderStream = true;  // 撤单为逐笔委托 type 10
+    static constexpr bool kCancelInTradeStream = false; // 撤单为逐笔成交 type 1
+    static constexpr bool kAggressorOffBook = true;     // 成交方向与委托方向相同的一方不在簿中
+
+    // 逐笔委托在通道内的序号: 上交所为逐笔数据序号
+    static int orderSequence(const L2Order& order) { return order.num3; }
+};
+
+// 深交所:
+//   逐笔委托 --> 限价2 入簿, 市价1/本方最优3 价格未知不入簿
+//   逐笔成交 --> type 1 为撤单, 其余为成交, 成交双方的限价委托均在簿中
+struct SzsePolicy {
+    static constexpr const char* kMarket = "SZ";
+    static constexpr bool kCancelInOrderStream = false;
+    static constexpr bool kCancelInTradeStream = true;
+    static constexpr bool kAggressorOffBook = false;
+
+    // 逐笔委托在通道内的序号: 深交所委托编号即通道内序号
+    static int orderSequence(const L2Order& order) { return order.num1; }
+};
+
+// 按合约代码后缀(.SH/.SZ)判断是否上交所, 无后缀时按首位 6 判断
+// 订单簿市场(makeOrderBook)与逐笔委托编号取值(L2Schema)都以此为准
+inline bool isSseSymbol(std::string_view symbol) {
+    size_t dot_pos = symbol.rfind('.');
+    if (dot_pos != std::string_view::npos) {
+        return symbol.substr(dot_pos + 1) == "SH";
+    }
+    return !symbol.empty() && symbol[0] == '6';
+}
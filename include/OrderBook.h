@@ -1,68 +1,104 @@
 #pragma once
+#include <memory>
 #include <string>
-#include <map>
-#include <list>
-#include <thread>
 #include <atomic>
 #include <unordered_map>
-#include <unordered_set>
 #include <vector>
 
-#include "concurrentqueue/blockingconcurrentqueue.h"
+#include "concurrentqueue/concurrentqueue.h"
 #include "DataStruct.h"
 #include "SendServer.h"
 #include "AutoSaveJsonMap.hpp"
-#include "DoubleBufferSlot.h"
+#include "BookSnapshot.h"
+#include "ChannelWatermark.h"
+#include "MarketPolicy.h"
+#include "PipelineConfig.h"
+#include "PriceBandConfig.h"
+#include "PriceLevelArray.h"
+#include "SlabArena.h"
+#include "OrderIdIndex.h"
+#include "PendingMatchStore.h"
+#include "QueuePositionTracker.h"
+#include "SeqLockSlot.h"
+#include "SlidingWindowAggregator.h"
+#include "ShardWorkerPool.h"
+#include "SpscRingBuffer.h"
+#include "TripleBufferSlot.h"
+
+
+// 订单簿公共部分: 对外接口、订单簿状态与各市场通用的处理逻辑
+// 逐笔事件的处理依赖交易所规则, 由 OrderBook<Policy> 实现, 通过 makeOrderBook 按合约代码创建
+// OrderBook 不持有线程, 由 ShardWorkerPool 的处理线程调用 poll() 推进, 同一时刻只在一个线程上处理
+class OrderBookBase {
+public:
+    virtual ~OrderBookBase();
 
+    void pushHistoryEvent(const MarketEvent& event);
+    void pushHistoryEvents(const MarketEvent* events, size_t count);
+    void pushEvent(const MarketEvent& event);
+    bool pushEvents(size_t stream, const MarketEvent* events, size_t count);
+    void stop();
 
-class OrderBook {
-public:
-    explicit OrderBook(
+    // 以下由 ShardWorkerPool 调用
+    // 绑定所属处理线程的就绪队列, 绑定前已收到的事件随即调度
+    void bindReadyQueue(BookReadyQueue* ready_queue);
+    // 有新事件时把自身放入就绪队列, 已在队列中时不重复放入
+    void schedule();
+    // 处理线程取出本 OrderBook 后、调用 poll() 前清除调度标记
+    void clearScheduled();
+    // 处理一批事件, 返回是否仍有积压需要再次调度
+    virtual bool poll() = 0;
+    // 处理线程每秒调用一次: 打印订单簿, 历史数据阶段复查加载是否完成
+    void onTimer();
+
+    // 最近一次发布的订单簿快照, 任意线程可调用, 不阻塞处理线程
+    BookSnapshot snapshot() const { return snapshot_.read(); }
+    // 按快照打印前 level_num 档(不超过 BookSnapshot::kDepth)及计数器, 任意线程可调用
+    void printOrderBook(int level_num) const;
+
+    std::atomic<bool> is_history_order_done_{false};
+    std::atomic<bool> is_history_trade_done_{false};
+
+protected:
+    OrderBookBase(
         const std::string symbol,
         const int vol_flag,
+        const PipelineConfig& pipeline_config,
+        const PriceBandConfig& price_band_config,
         SendServer& sendServer_ref,
         SendServer& queueSendServer_ref,
         AutoSaveJsonMap<std::string, std::vector<int>>& cancelMonitorInfo_ref,
         AutoSaveJsonMap<std::string, std::unordered_map<int, int>>& sellMonitorInfo_ref,
         AutoSaveJsonMap<std::string, std::vector<int>>& queueMonitorInfo_ref
     );
-    ~OrderBook();
-
-    void pushHistoryEvent(const MarketEvent& event);
-    void pushEvent(const MarketEvent& event);
-    void stop();
-
-    std::atomic<bool> is_history_order_done_{false};
-    std::atomic<bool> is_history_trade_done_{false};
 
-private:
     bool isHistoryDataLoadingComplete() const;
-    void generateDuplicateSets();
-    void runProcessingLoop();
-    void handleOrderEvent(const MarketEvent& event);
-    void handleTradeEvent(const MarketEvent& event);
 
-    bool isOrderExists(const int order_id) const;
     void addOrder(const L2Order& order);
-    void onTrade(const int order_id, const int trade_volume, const int trade_side);
-    void onCancelOrder(const int order_id, const int cancel_volume);
-    void removeOrder(const int order_id);
-    void printOrderBook(int level_num) const;
-    void printloop(int level_num);
+    void onCancelOrder(const uint32_t slot, const int cancel_volume);
+    void removeOrder(const uint32_t slot);
+    void publishSnapshot();
 
     void checkLimitUpWithdrawal(int timestamp);
+    void trackQueuePrice(int price, const std::vector<int>& monitor_volumes);
+    void compactQueueTracker();
+    void untrackQueuePrice();
+    size_t dequeueEvents();
+    bool isLive() const;
 
-    // 订单簿相关数据结构
+    // 订单簿相关数据结构, 节点存放在 order_pool_ 中, prev/next 为同价位排队链表的前后槽位号
     struct OrderRef {
         int volume;
         int price;
-        int side;
         int id;
         int timestamp;
+        uint32_t prev;
+        uint32_t next;
+        uint32_t queue_seq; // 在 queue_tracker_ 中的编号, 不在跟踪价位时为 kUntracked
+        int side;
     };
     
     std::string symbol_;
-    std::string market_flag_;
 
     int vol_flag_ = 0; // 用于识别订单排位的数量标记
     
@@ -70,56 +106,73 @@ private:
     int fengdan_volume_ = 0; // 当前封单量
     int last_event_timestamp_ = 0; // 最后一笔事件的时间戳
 
-    // 历史事件排序缓冲区
+    // 历史事件排序缓冲区, 排序后从 history_replay_pos_ 起按块回放
     std::vector<MarketEvent> history_event_buffer_;
+    bool history_sorted_ = false;
+    size_t history_replay_pos_ = 0;
+    double history_replay_seconds_ = 0.0; // 各块回放累计耗时
 
-    // 历史数据去重集合
-    std::vector<std::pair<int, int>> history_order_timeId_;
-    std::vector<std::pair<int, int>> history_trade_timeId_;
-    std::unordered_set<int> history_order_id_;
-    std::unordered_set<int> history_trade_id_;
+    // 历史数据回放到的各通道最大序号, 用于实时数据去重
+    ChannelWatermark history_order_watermark_;
+    ChannelWatermark history_trade_watermark_;
 
-    // 封单比例时间窗口
-    std::map<int, double> limit_up_fengdan_ratios_;
+    // 封单比例时间窗口, 按事件时间维护窗口内最大值
+    SlidingWindowAggregator<double, WindowMax<double>> limit_up_fengdan_ratios_;
 
-    // 封单数量时间窗口
-    std::map<int, int> limit_up_fengdan_volumes_;
+    // 封单数量时间窗口, 按事件时间维护窗口内最大值
+    SlidingWindowAggregator<int, WindowMax<int>> limit_up_fengdan_volumes_;
 
-    // 排单位置号序列
-    DoubleBufferSlot<std::vector<std::vector<int>>> order_position_index_db_;
+    // 排单位置号序列, 处理线程发布, 打印时钉住读取
+    TripleBufferSlot<std::vector<std::vector<int>>> order_position_index_db_;
 
-    // 价格 → 该档位总挂单量
-    std::map<int, int> bid_volume_at_price_;
-    std::map<int, int> ask_volume_at_price_;
+    // 涨停价位监控挂单量的排队位置, 随订单增删增量更新
+    QueuePositionTracker queue_tracker_;
+    std::optional<std::vector<int>> queue_monitor_volumes_; // queueMonitorInfo_ref_ 中本合约的监控挂单量
+    uint64_t queue_monitor_version_ = UINT64_MAX;            // 读取 queue_monitor_volumes_ 时的版本号
+    std::vector<std::vector<int>> queue_positions_;
 
-    // 按价格分组的买卖订单簿
-    std::map<int,std::list<OrderRef>> bids_;
-    std::map<int,std::list<OrderRef>> asks_;
+    // 按价格档位组织的买卖订单簿, 档位内联总挂单量并按到达顺序排队
+    PriceLevelArray<IntrusiveFifo> bids_;
+    PriceLevelArray<IntrusiveFifo> asks_;
 
-    // 待成交事件集合<order_id, 事件列表>
-    std::unordered_map<int, std::vector<MarketEvent>> pending_trade_events_;
+    // 在簿订单节点池
+    SlabArena<OrderRef> order_pool_;
 
-    // 待撤单事件集合<order_id, 事件列表>
-    std::unordered_map<int, MarketEvent> pending_cancel_events_;
+    // 委托未到达时暂存的成交与撤单, 委托到达后补处理, 超期丢弃
+    PendingMatchStore pending_matches_;
+    uint64_t event_seq_ = 0; // 已处理的逐笔委托与成交数
 
     // 快速查找订单
-    std::unordered_map<int, std::list<OrderRef>::iterator> order_index_;
+    OrderIdIndex order_index_; // 订单编号 -> order_pool_ 槽位号
 
-    // 事件队列 - MPSC
-    moodycamel::BlockingConcurrentQueue<MarketEvent> history_event_queue;
-    moodycamel::BlockingConcurrentQueue<MarketEvent> event_queue;
+    // 事件队列 - MPSC, 由处理线程非阻塞取出
+    moodycamel::ConcurrentQueue<MarketEvent> history_event_queue;
+    moodycamel::ConcurrentQueue<MarketEvent> event_queue;
+
+    // 实时事件 SPSC 通道, 仅 queue_type = spsc 时创建, 每路行情一个, 生产者为 DataRouter 对应路的线程
+    struct EventChannel {
+        std::unique_ptr<SpscRingBuffer<MarketEvent>> ring;
+        std::vector<MarketEvent> spill; // 环形缓冲区满时的生产者侧暂存, 仅生产者访问
+        size_t spill_head = 0;
+    };
+    EventChannel event_channels_[kL2StreamCount];
+    size_t next_channel_ = 0;   // 下一次优先取的通道, 轮换避免饿死
+
+    // 每次 poll() 最多批量取出的事件数
+    size_t drain_limit_;
+    std::vector<MarketEvent> drain_buffer_;
+
+    // 所属处理线程的就绪队列与调度标记
+    std::atomic<BookReadyQueue*> ready_queue_{nullptr};
+    std::atomic<bool> scheduled_{false};
 
-    // 工作线程
-    std::thread processing_thread_;
-    std::thread print_thread_;
     std::atomic<bool> running_{true};
     std::atomic<bool> is_cancel_send_{false};
     std::atomic<bool> is_sell_send_{false};
-    std::atomic<bool> is_history_event_queue_done_{false};
     std::atomic<bool> is_history_event_buffer_done_{false};
-    
-    // 锁
-    mutable std::mutex mtx_;
+
+    // 处理线程每批事件后发布的快照, 订单簿本身只由处理线程访问
+    SeqLockSlot<BookSnapshot> snapshot_;
 
     // 循环事件计数器
     long loop_count_ = 0;
@@ -131,3 +184,45 @@ private:
     AutoSaveJsonMap<std::string, std::unordered_map<int, int>>& sellMonitorInfo_ref_;
     AutoSaveJsonMap<std::string, std::vector<int>>& queueMonitorInfo_ref_;
 };
+
+// 按交易所规则 Policy(SsePolicy/SzsePolicy) 特化的订单簿, 逐笔事件处理路径上没有运行期市场判断
+template<typename Policy>
+class OrderBook : public OrderBookBase {
+public:
+    explicit OrderBook(
+        const std::string symbol,
+        const int vol_flag,
+        const PipelineConfig& pipeline_config,
+        const PriceBandConfig& price_band_config,
+        SendServer& sendServer_ref,
+        SendServer& queueSendServer_ref,
+        AutoSaveJsonMap<std::string, std::vector<int>>& cancelMonitorInfo_ref,
+        AutoSaveJsonMap<std::string, std::unordered_map<int, int>>& sellMonitorInfo_ref,
+        AutoSaveJsonMap<std::string, std::vector<int>>& queueMonitorInfo_ref
+    );
+
+    bool poll() override;
+
+private:
+    bool pollHistory();
+    void reserveHistoryLevels(const MarketEvent* events, size_t count);
+    void replayHistory(const MarketEvent* events, size_t count);
+    bool pollLive();
+    void handleOrderEvent(const MarketEvent& event);
+    void handleTradeEvent(const MarketEvent& event);
+    void onTrade(const uint32_t slot, const int trade_volume, const int trade_side);
+    void applyPendingMatches(int order_id);
+};
+
+// 按合约代码所属交易所创建 OrderBook<SsePolicy> 或 OrderBook<SzsePolicy>
+std::unique_ptr<OrderBookBase> makeOrderBook(
+    const std::string symbol,
+    const int vol_flag,
+    const PipelineConfig& pipeline_config,
+    const PriceBandConfig& price_band_config,
+    SendServer& sendServer_ref,
+    SendServer& queueSendServer_ref,
+    AutoSaveJsonMap<std::string, std::vector<int>>& cancelMonitorInfo_ref,
+    AutoSaveJsonMap<std::string, std::unordered_map<int, int>>& sellMonitorInfo_ref,
+    AutoSaveJsonMap<std::string, std::vector<int>>& queueMonitorInfo_ref
+);
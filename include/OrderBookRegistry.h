@@ -0,0 +1,81 @@
+// OrderBookRegistry.h
+#pragma once
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+#include "OrderBook.h"
+#include "SymbolTable.h"
+
+// 合约 --> OrderBook 注册表, 读多写少
+// 按 SymbolId 直接下标的定长原子指针数组, 查找为一次原子读, 无锁无等待;
+// 写者(Executor 监控线程)加锁后原子发布新 OrderBook, 读者随时可见.
+// OrderBook 只增不删, 发布后存活到注册表析构, 读者查到的指针无需登记即可一直使用;
+// 注册表须在所有读者(DataRouter、L2HttpDownloader、ShardWorkerPool)停止后析构
+class OrderBookRegistry {
+public:
+    OrderBookRegistry()
+        : books_(std::make_unique<std::atomic<OrderBookBase*>[]>(SymbolTable::kMaxSymbols)),
+          owners_(SymbolTable::kMaxSymbols) {
+        for (size_t i = 0; i < SymbolTable::kMaxSymbols; ++i) {
+            books_[i].store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    OrderBookRegistry(const OrderBookRegistry&) = delete;
+    OrderBookRegistry& operator=(const OrderBookRegistry&) = delete;
+
+    // 无锁无等待查找, 不存在时返回 nullptr
+    OrderBookBase* find(SymbolId id) const {
+        if (id >= SymbolTable::kMaxSymbols) {
+            return nullptr;
+        }
+        return books_[id].load(std::memory_order_acquire);
+    }
+
+    OrderBookBase* find(std::string_view symbol) const {
+        return find(SymbolTable::instance().find(symbol));
+    }
+
+    // 写者: 发布 symbol 的 OrderBook, 已存在或代码非法时返回 nullptr, book 随之释放
+    OrderBookBase* add(std::string_view symbol, std::unique_ptr<OrderBookBase> book) {
+        SymbolId id = SymbolTable::instance().intern(symbol);
+        if (id == kInvalidSymbolId) {
+            return nullptr;
+        }
+
+        std::lock_guard<std::mutex> lock(write_mtx_);
+        if (owners_[id]) {
+            return nullptr;
+        }
+        owners_[id] = std::move(book);
+        books_[id].store(owners_[id].get(), std::memory_order_release);
+        ++size_;
+        return owners_[id].get();
+    }
+
+    // 写者侧遍历全部已发布的 OrderBook
+    template<typename Fn>
+    void forEach(Fn&& fn) {
+        std::lock_guard<std::mutex> lock(write_mtx_);
+        for (auto& owner : owners_) {
+            if (owner) {
+                fn(*owner);
+            }
+        }
+    }
+
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(write_mtx_);
+        return size_;
+    }
+
+private:
+    std::unique_ptr<std::atomic<OrderBookBase*>[]> books_; // SymbolId -> 已发布的 OrderBook
+    std::vector<std::unique_ptr<OrderBookBase>> owners_;     // SymbolId -> 所有权, 仅写者访问
+    size_t size_ = 0;
+
+    mutable std::mutex write_mtx_;
+};
@@ -0,0 +1,248 @@
+// OrderIdIndex.h
+#pragma once
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+#include "SlabArena.h"
+
+// 订单编号 -> 订单节点槽位号
+// 同一合约的订单编号按通道大致递增, 绝大多数编号落在以首个编号为起点的窗口内:
+//   1. 窗口内的编号直接按偏移量分页索引, 页按需分配, 页内全部删除后回收复用, 查找/插入/删除都是一次数组访问;
+//   2. 窗口外(更早或跨度过大)的编号, 以及分页达到上限后新出现的编号, 放入线性探测哈希表,
+//      删除时后移填补空位, 不留墓碑, 探测链长度不随删除累积
+// 值 kNullSlot 保留为"不存在"
+class OrderIdIndex {
+public:
+    static constexpr size_t kPageShift = 10;                        // 每页 1024 个编号
+    static constexpr size_t kPageSize = size_t(1) << kPageShift;
+    static constexpr long long kMaxSpan = 1LL << 26;                 // 分页窗口覆盖的编号跨度
+    static constexpr size_t kMaxPages = 4096;                        // 同时存在的页数上限, 即分页部分最多占用 16MB
+
+    struct Stats {
+        size_t direct_entries = 0; // 分页部分的编号数
+        size_t hashed_entries = 0; // 哈希部分的编号数
+        size_t live_pages = 0;     // 使用中的页数
+        size_t hash_capacity = 0;  // 哈希表槽位数
+    };
+
+    OrderIdIndex() = default;
+    OrderIdIndex(const OrderIdIndex&) = delete;
+    OrderIdIndex& operator=(const OrderIdIndex&) = delete;
+
+    // 不存在时返回 kNullSlot
+    uint32_t find(int id) const {
+        size_t page_no;
+        size_t offset;
+        if (locate(id, page_no, offset) && page_no < page_table_.size() && page_table_[page_no] != kNullSlot) {
+            uint32_t slot = pages_[page_table_[page_no]]->slots[offset];
+            if (slot != kNullSlot) {
+                return slot;
+            }
+        }
+        return stats_.hashed_entries == 0 ? kNullSlot : hashFind(id);
+    }
+
+    // 写入 id -> slot, 一次定位完成查找与插入, 返回原槽位号(原先不存在时为 kNullSlot)
+    uint32_t exchange(int id, uint32_t slot) {
+        if (!has_base_) {
+            base_id_ = static_cast<long long>(id) - static_cast<long long>(id) % static_cast<long long>(kPageSize);
+            has_base_ = true;
+        }
+
+        size_t page_no;
+        size_t offset;
+        Page* page = locate(id, page_no, offset) ? obtainPage(page_no) : nullptr;
+        if (page == nullptr) {
+            return hashExchange(id, slot);
+        }
+
+        uint32_t previous = page->slots[offset];
+        if (previous == kNullSlot) {
+            ++page->count;
+            ++stats_.direct_entries;
+
+            // 页分配前可能因页数上限落入了哈希表
+            if (stats_.hashed_entries > 0) {
+                previous = hashErase(id);
+            }
+        }
+
+        page->slots[offset] = slot;
+        return previous;
+    }
+
+    // 返回被删除的槽位号, 不存在时返回 kNullSlot
+    uint32_t erase(int id) {
+        size_t page_no;
+        size_t offset;
+        if (locate(id, page_no, offset) && page_no < page_table_.size() && page_table_[page_no] != kNullSlot) {
+            Page& page = *pages_[page_table_[page_no]];
+            uint32_t slot = page.slots[offset];
+            if (slot != kNullSlot) {
+                page.slots[offset] = kNullSlot;
+                --stats_.direct_entries;
+                if (--page.count == 0) {
+                    releasePage(page_no);
+                }
+                return slot;
+            }
+        }
+        return stats_.hashed_entries == 0 ? kNullSlot : hashErase(id);
+    }
+
+    size_t size() const { return stats_.direct_entries + stats_.hashed_entries; }
+
+    const Stats& stats() const { return stats_; }
+
+private:
+    struct Page {
+        uint32_t slots[kPageSize];
+        uint32_t count;
+    };
+
+    static constexpr int kEmptyKey = INT_MIN;
+
+    bool locate(int id, size_t& page_no, size_t& offset) const {
+        long long delta = static_cast<long long>(id) - base_id_;
+        if (!has_base_ || delta < 0 || delta >= kMaxSpan) {
+            return false;
+        }
+        page_no = static_cast<size_t>(delta) >> kPageShift;
+        offset = static_cast<size_t>(delta) & (kPageSize - 1);
+        return true;
+    }
+
+    Page* obtainPage(size_t page_no) {
+        if (page_no < page_table_.size() && page_table_[page_no] != kNullSlot) {
+            return pages_[page_table_[page_no]].get();
+        }
+        if (stats_.live_pages >= kMaxPages) {
+            return nullptr;
+        }
+
+        if (page_no >= page_table_.size()) {
+            page_table_.resize(page_no + 1, kNullSlot);
+        }
+
+        uint32_t page_index;
+        if (!free_pages_.empty()) {
+            page_index = free_pages_.back();
+            free_pages_.pop_back();
+        } else {
+            page_index = static_cast<uint32_t>(pages_.size());
+            pages_.push_back(std::make_unique<Page>());
+        }
+
+        Page& page = *pages_[page_index];
+        std::fill(std::begin(page.slots), std::end(page.slots), kNullSlot);
+        page.count = 0;
+        page_table_[page_no] = page_index;
+        ++stats_.live_pages;
+        return &page;
+    }
+
+    void releasePage(size_t page_no) {
+        free_pages_.push_back(page_table_[page_no]);
+        page_table_[page_no] = kNullSlot;
+        --stats_.live_pages;
+    }
+
+    size_t home(int id) const {
+        return static_cast<size_t>((static_cast<uint32_t>(id) * 0x9E3779B1u) >> hash_shift_);
+    }
+
+    uint32_t hashFind(int id) const {
+        for (size_t i = home(id);; i = (i + 1) & hash_mask_) {
+            if (hash_keys_[i] == id) return hash_values_[i];
+            if (hash_keys_[i] == kEmptyKey) return kNullSlot;
+        }
+    }
+
+    uint32_t hashExchange(int id, uint32_t slot) {
+        if ((stats_.hashed_entries + 1) * 2 > hash_keys_.size()) {
+            rehash(hash_keys_.empty() ? 64 : hash_keys_.size() * 2);
+        }
+
+        size_t i = home(id);
+        while (hash_keys_[i] != kEmptyKey && hash_keys_[i] != id) {
+            i = (i + 1) & hash_mask_;
+        }
+
+        if (hash_keys_[i] == id) {
+            uint32_t previous = hash_values_[i];
+            hash_values_[i] = slot;
+            return previous;
+        }
+
+        hash_keys_[i] = id;
+        hash_values_[i] = slot;
+        ++stats_.hashed_entries;
+        return kNullSlot;
+    }
+
+    uint32_t hashErase(int id) {
+        size_t i = home(id);
+        while (hash_keys_[i] != id) {
+            if (hash_keys_[i] == kEmptyKey) return kNullSlot;
+            i = (i + 1) & hash_mask_;
+        }
+        uint32_t slot = hash_values_[i];
+
+        // 后移删除: 把后续探测链上可以前移的元素填入空位
+        for (size_t j = (i + 1) & hash_mask_; hash_keys_[j] != kEmptyKey; j = (j + 1) & hash_mask_) {
+            size_t k = home(hash_keys_[j]);
+            bool movable = (i <= j) ? (k <= i || k > j) : (k <= i && k > j);
+            if (movable) {
+                hash_keys_[i] = hash_keys_[j];
+                hash_values_[i] = hash_values_[j];
+                i = j;
+            }
+        }
+        hash_keys_[i] = kEmptyKey;
+        --stats_.hashed_entries;
+        return slot;
+    }
+
+    void rehash(size_t capacity) {
+        std::vector<int> keys(capacity, kEmptyKey);
+        std::vector<uint32_t> values(capacity, kNullSlot);
+        keys.swap(hash_keys_);
+        values.swap(hash_values_);
+        hash_mask_ = capacity - 1;
+        hash_shift_ = 32;
+        while ((size_t(1) << (32 - hash_shift_)) < capacity) {
+            --hash_shift_;
+        }
+        stats_.hash_capacity = capacity;
+
+        for (size_t i = 0; i < keys.size(); ++i) {
+            if (keys[i] == kEmptyKey) continue;
+            size_t j = home(keys[i]);
+            while (hash_keys_[j] != kEmptyKey) {
+                j = (j + 1) & hash_mask_;
+            }
+            hash_keys_[j] = keys[i];
+            hash_values_[j] = values[i];
+        }
+    }
+
+    // 分页部分
+    bool has_base_ = false;
+    long long base_id_ = 0;
+    std::vector<uint32_t> page_table_; // 页号 -> pages_ 下标
+    std::vector<std::unique_ptr<Page>> pages_;
+    std::vector<uint32_t> free_pages_;
+
+    // 哈希部分, 容量为 2 的幂
+    std::vector<int> hash_keys_;
+    std::vector<uint32_t> hash_values_;
+    size_t hash_mask_ = 0;
+    int hash_shift_ = 32;
+
+    Stats stats_;
+};
@@ -0,0 +1,182 @@
+// PendingMatchStore.h
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#include "SlabArena.h"
+#include "OrderIdIndex.h"
+
+// 等待原始委托到达的成交/撤单类型
+enum class PendingKind : uint8_t {
+    TRADE,
+    CANCEL
+};
+
+// 乱序到达的成交/撤单, 只保留补处理所需字段
+struct PendingMatch {
+    int order_id;
+    int volume;
+    int side;
+    int timestamp;      // 事件时间
+    uint64_t seq;       // 暂存时订单簿已处理的事件数
+    uint32_t next;      // 同一订单编号的下一条, 空闲时为空闲链表
+    uint32_t age_prev;  // 全部暂存记录按到达顺序的双向链表
+    uint32_t age_next;
+    PendingKind kind;
+};
+
+// 乱序成交/撤单暂存区
+// 记录存放在 SlabArena 中, 按订单编号串成到达顺序的单向链表, 编号 -> 链表头由 OrderIdIndex 索引;
+// 全部记录另按到达顺序串成双向链表, 最早到达的记录必为其所在编号链表的表头, 超期时从两端 O(1) 移除
+// 市价单对手方、启动前已存在的订单等永远等不到委托的记录, 超过时间或事件数期限后丢弃, 常驻记录数有上界
+class PendingMatchStore {
+public:
+    struct Stats {
+        size_t resident = 0;       // 当前暂存记录数
+        size_t peak = 0;           // 暂存记录数峰值
+        uint64_t parked = 0;       // 累计暂存
+        uint64_t matched_late = 0; // 委托到达后补处理
+        uint64_t expired = 0;      // 超期丢弃
+        uint64_t replaced = 0;     // 同一订单的撤单被后到的撤单覆盖
+    };
+
+    // max_age_ms / max_events 为 0 时不按该条件丢弃
+    PendingMatchStore(int max_age_ms, uint64_t max_events)
+        : max_age_ms_(max_age_ms), max_events_(max_events) {}
+
+    PendingMatchStore(const PendingMatchStore&) = delete;
+    PendingMatchStore& operator=(const PendingMatchStore&) = delete;
+
+    bool empty() const { return stats_.resident == 0; }
+
+    // 暂存一条记录; 同一订单只保留最后一条撤单
+    void park(int order_id, PendingKind kind, int volume, int side, int timestamp, uint64_t seq) {
+        if (kind == PendingKind::CANCEL) {
+            uint32_t prev = kNullSlot;
+            for (uint32_t slot = index_.find(order_id); slot != kNullSlot; prev = slot, slot = pool_[slot].next) {
+                if (pool_[slot].kind == PendingKind::CANCEL) {
+                    unlinkFromOrder(order_id, prev, slot);
+                    release(slot);
+                    ++stats_.replaced;
+                    break;
+                }
+            }
+        }
+
+        uint32_t slot = pool_.allocate();
+        PendingMatch& match = pool_[slot];
+        match.order_id = order_id;
+        match.volume = volume;
+        match.side = side;
+        match.timestamp = timestamp;
+        match.seq = seq;
+        match.next = kNullSlot;
+        match.kind = kind;
+
+        // 接到编号链表末尾
+        uint32_t head = index_.find(order_id);
+        if (head == kNullSlot) {
+            index_.exchange(order_id, slot);
+        } else {
+            uint32_t tail = head;
+            while (pool_[tail].next != kNullSlot) {
+                tail = pool_[tail].next;
+            }
+            pool_[tail].next = slot;
+        }
+
+        // 接到到达顺序链表末尾
+        match.age_prev = age_tail_;
+        match.age_next = kNullSlot;
+        if (age_tail_ == kNullSlot) {
+            age_head_ = slot;
+        } else {
+            pool_[age_tail_].age_next = slot;
+        }
+        age_tail_ = slot;
+
+        ++stats_.parked;
+        if (++stats_.resident > stats_.peak) {
+            stats_.peak = stats_.resident;
+        }
+    }
+
+    // 按到达顺序对 order_id 的全部记录调用 f(const PendingMatch&), 随后移除, 返回记录数
+    template<typename F>
+    size_t take(int order_id, F&& f) {
+        if (empty()) {
+            return 0;
+        }
+
+        uint32_t slot = index_.erase(order_id);
+        size_t count = 0;
+        while (slot != kNullSlot) {
+            uint32_t next = pool_[slot].next;
+            f(static_cast<const PendingMatch&>(pool_[slot]));
+            release(slot);
+            ++count;
+            slot = next;
+        }
+        stats_.matched_late += count;
+        return count;
+    }
+
+    // 丢弃事件时间早于 now_timestamp - max_age_ms, 或暂存后又处理了超过 max_events 个事件的记录
+    void expire(int now_timestamp, uint64_t now_seq) {
+        while (age_head_ != kNullSlot) {
+            const PendingMatch& oldest = pool_[age_head_];
+            bool too_old = max_age_ms_ > 0 && oldest.timestamp < now_timestamp - max_age_ms_;
+            bool too_far = max_events_ > 0 && oldest.seq + max_events_ < now_seq;
+            if (!too_old && !too_far) {
+                break;
+            }
+
+            uint32_t slot = age_head_;
+            unlinkFromOrder(oldest.order_id, kNullSlot, slot);
+            release(slot);
+            ++stats_.expired;
+        }
+    }
+
+    const Stats& stats() const { return stats_; }
+
+private:
+    // 从编号链表移除 slot, prev 为其前一条(表头时为 kNullSlot)
+    void unlinkFromOrder(int order_id, uint32_t prev, uint32_t slot) {
+        uint32_t next = pool_[slot].next;
+        if (prev != kNullSlot) {
+            pool_[prev].next = next;
+        } else if (next != kNullSlot) {
+            index_.exchange(order_id, next);
+        } else {
+            index_.erase(order_id);
+        }
+    }
+
+    // 从到达顺序链表移除并归还槽位
+    void release(uint32_t slot) {
+        PendingMatch& match = pool_[slot];
+        if (match.age_prev == kNullSlot) {
+            age_head_ = match.age_next;
+        } else {
+            pool_[match.age_prev].age_next = match.age_next;
+        }
+        if (match.age_next == kNullSlot) {
+            age_tail_ = match.age_prev;
+        } else {
+            pool_[match.age_next].age_prev = match.age_prev;
+        }
+
+        pool_.release(slot);
+        --stats_.resident;
+    }
+
+    int max_age_ms_;
+    uint64_t max_events_;
+
+    SlabArena<PendingMatch, 10> pool_;
+    OrderIdIndex index_;
+    uint32_t age_head_ = kNullSlot;
+    uint32_t age_tail_ = kNullSlot;
+    Stats stats_;
+};
@@ -0,0 +1,39 @@
+// PipelineConfig.h
+#pragma once
+#include <string>
+
+#include "ConfigReader.h"
+#include "WaitStrategy.h"
+
+// 接收线程 --> DataRouter --> OrderBook 各跳使用的队列类型
+enum class QueueType {
+    MOODYCAMEL, // moodycamel::BlockingConcurrentQueue, 通用 MPMC 队列
+    SPSC        // SpscRingBuffer + WaitStrategy, 每跳单生产者单消费者
+};
+
+inline const char* queueTypeName(QueueType type) {
+    return type == QueueType::SPSC ? "spsc" : "moodycamel";
+}
+
+// 数据管道配置, 对应 config.ini 的 [pipeline] 段
+struct PipelineConfig {
+    int route_batch_size = 256;  // DataRouter 单次批量投递的最大事件数
+    int drain_limit = 512;       // OrderBook 单次唤醒最多处理的事件数
+    QueueType queue_type = QueueType::MOODYCAMEL;
+    WaitMode wait_mode = WaitMode::BLOCK; // [threads] 段未单独配置 <name>_wait 时各消费线程的等待方式
+    int ring_capacity = 65536;   // SPSC 环形缓冲区容量, 向上取整为 2 的幂
+    int pending_max_age_ms = 60000;      // 乱序成交/撤单最长等待委托的时间(毫秒), 0 为不限
+    int pending_max_events = 1000000;    // 乱序成交/撤单最长等待的事件数, 0 为不限
+};
+
+inline PipelineConfig loadPipelineConfig(const ConfigReader& config) {
+    PipelineConfig pipeline;
+    pipeline.route_batch_size = config.getInt("pipeline", "route_batch_size", pipeline.route_batch_size);
+    pipeline.drain_limit = config.getInt("pipeline", "drain_limit", pipeline.drain_limit);
+    pipeline.queue_type = config.get("pipeline", "queue_type") == "spsc" ? QueueType::SPSC : QueueType::MOODYCAMEL;
+    pipeline.wait_mode = parseWaitMode(config.get("pipeline", "wait_strategy"), pipeline.wait_mode);
+    pipeline.ring_capacity = config.getInt("pipeline", "ring_capacity", pipeline.ring_capacity);
+    pipeline.pending_max_age_ms = config.getInt("pipeline", "pending_max_age_ms", pipeline.pending_max_age_ms);
+    pipeline.pending_max_events = config.getInt("pipeline", "pending_max_events", pipeline.pending_max_events);
+    return pipeline;
+}
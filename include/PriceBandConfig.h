@@ -0,0 +1,91 @@
+// PriceBandConfig.h
+#pragma once
+#include <cctype>
+#include <cmath>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "ConfigReader.h"
+#include "Logger.h"
+
+// 合约涨跌停价格区间, 单位 0.0001 元
+struct PriceBand {
+    int limit_down = 0;
+    int limit_up = 0;
+};
+
+// 订单簿价格档位数组配置, 对应 config.ini 的 [price_band] 段:
+//   tick = 100              最小价格变动单位(0.0001 元), 默认 0.01 元
+//   default_pct = 20        未配置区间的合约, 按首个挂单价推算区间所用的涨跌幅(%)
+//   600000 = 9.00,11.00     合约跌停价,涨停价(元), 代码可带或不带 .SH/.SZ 后缀
+struct PriceBandConfig {
+    int tick = 100;
+    int default_pct = 20;
+    std::unordered_map<std::string, PriceBand> bands; // 键为去掉后缀的 6 位代码
+
+    // 去掉 .SH/.SZ 后缀, 剩余部分不是 6 位数字时返回空串
+    static std::string normalizeCode(std::string_view symbol) {
+        size_t dot_pos = symbol.rfind('.');
+        if (dot_pos != std::string_view::npos) {
+            std::string_view suffix = symbol.substr(dot_pos + 1);
+            if (suffix != "SH" && suffix != "SZ" && suffix != "sh" && suffix != "sz") {
+                return {};
+            }
+            symbol = symbol.substr(0, dot_pos);
+        }
+
+        if (symbol.size() != 6) {
+            return {};
+        }
+        for (char c : symbol) {
+            if (!std::isdigit(static_cast<unsigned char>(c))) {
+                return {};
+            }
+        }
+        return std::string(symbol);
+    }
+
+    const PriceBand* find(std::string_view symbol) const {
+        auto it = bands.find(normalizeCode(symbol));
+        return it != bands.end() ? &it->second : nullptr;
+    }
+};
+
+inline PriceBandConfig loadPriceBandConfig(const ConfigReader& config) {
+    PriceBandConfig price_band;
+    price_band.tick = config.getInt("price_band", "tick", price_band.tick);
+    price_band.default_pct = config.getInt("price_band", "default_pct", price_band.default_pct);
+
+    for (const auto& [key, value] : config.getSection("price_band")) {
+        if (key == "tick" || key == "default_pct") {
+            continue;
+        }
+
+        std::string code = PriceBandConfig::normalizeCode(key);
+        if (code.empty()) {
+            LOG_WARN("PriceBandConfig", "[price_band] {} 不是合约代码(6 位数字, 可带 .SH/.SZ 后缀), 已忽略", key);
+            continue;
+        }
+
+        size_t comma_pos = value.find(',');
+        if (comma_pos == std::string::npos) {
+            LOG_WARN("PriceBandConfig", "[price_band] {} = {} 格式应为 跌停价,涨停价, 已忽略", key, value);
+            continue;
+        }
+
+        try {
+            PriceBand band;
+            band.limit_down = static_cast<int>(std::llround(std::stod(value.substr(0, comma_pos)) * 10000));
+            band.limit_up = static_cast<int>(std::llround(std::stod(value.substr(comma_pos + 1)) * 10000));
+            if (band.limit_down > 0 && band.limit_up >= band.limit_down) {
+                price_band.bands[code] = band;
+            } else {
+                LOG_WARN("PriceBandConfig", "[price_band] {} = {} 价格区间无效, 已忽略", key, value);
+            }
+        } catch (...) {
+            LOG_WARN("PriceBandConfig", "[price_band] {} = {} 价格无法解析, 已忽略", key, value);
+        }
+    }
+    return price_band;
+}
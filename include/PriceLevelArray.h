@@ -0,0 +1,364 @@
+// PriceLevelArray.h
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "FenwickTree.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// 无效价格, 查询不到有量档位时返回
+constexpr int kInvalidPrice = -1;
+
+// x 不能为 0
+inline int lowestSetBit(uint64_t x) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, x);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(x);
+#endif
+}
+
+// x 不能为 0
+inline int highestSetBit(uint64_t x) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse64(&index, x);
+    return static_cast<int>(index);
+#else
+    return 63 - __builtin_clzll(x);
+#endif
+}
+
+// 单边盘口的价格档位数组
+// 档位按 (price - base_price_) / tick_ 连续存放, base_price_ 通常为跌停价, 每档内联总挂单量、订单数与排队订单;
+// 两级位图记录有量的档位, 最优价与相邻有量档位由找首/末个置位得到, 增删改档位均为 O(1);
+// 另以树状数组维护各档挂单量的累计和, 区间挂单量查询为 O(log n), 不随档位数线性增长
+//
+// 未配置价格区间时以首个价格为中心按 auto_band_pct 推算区间; 之后出现区间外或不在 tick 网格上的价格,
+// 整体重建数组(扩大区间/细化 tick), 只在区间未知或配置有误时发生
+// 重建时档位整体移动, Queue 移动后须仍能定位原有元素(如只保存节点槽位号的 IntrusiveFifo)
+template<typename Queue>
+class PriceLevelArray {
+public:
+    struct Level {
+        int volume = 0;      // 档位总挂单量
+        int order_count = 0; // 档位排队订单数
+        Queue orders;        // 按到达顺序排队的订单
+    };
+
+    // 单边最多档位数, 超出时 obtain 返回 nullptr
+    static constexpr size_t kMaxLevels = size_t(1) << 22;
+
+    // tick: 最小价格变动单位(0.0001 元); auto_band_pct: 未配置区间时按首个价格推算区间所用的涨跌幅(%)
+    explicit PriceLevelArray(int tick = 100, int auto_band_pct = 20)
+        : tick_(tick > 0 ? tick : 1), auto_band_pct_(auto_band_pct > 0 && auto_band_pct < 100 ? auto_band_pct : 20) {}
+
+    // 保证 [low_price, high_price] 内的价格都有档位, 已有数据保留
+    bool reserve(int low_price, int high_price) {
+        if (low_price <= 0 || high_price < low_price) {
+            return false;
+        }
+
+        if (levels_.empty()) {
+            int base_price = low_price - low_price % tick_;
+            return rebuild(base_price, tick_, static_cast<size_t>((high_price - base_price) / tick_) + 1);
+        }
+
+        return expandTo(low_price) && expandTo(high_price);
+    }
+
+    // price 所在档位, 不在数组内时返回 nullptr
+    Level* find(int price) {
+        size_t index = 0;
+        return indexOf(price, index) ? &levels_[index] : nullptr;
+    }
+
+    const Level* find(int price) const {
+        size_t index = 0;
+        return indexOf(price, index) ? &levels_[index] : nullptr;
+    }
+
+    // price 所在档位, 不在数组内时扩展数组; 价格无法表示时返回 nullptr
+    Level* obtain(int price) {
+        size_t index = 0;
+        if (!indexOf(price, index)) {
+            if (!expandTo(price) || !indexOf(price, index)) {
+                return nullptr;
+            }
+        }
+        return &levels_[index];
+    }
+
+    // 调整档位总挂单量, 减到 0 及以下时档位量清零并移出位图
+    void addVolume(int price, int delta) {
+        size_t index = 0;
+        if (!indexOf(price, index)) {
+            if (delta <= 0 || !obtain(price)) {
+                return;
+            }
+            indexOf(price, index);
+        }
+
+        Level& level = levels_[index];
+        int old_volume = level.volume;
+        level.volume += delta;
+        if (level.volume > 0) {
+            setBit(index);
+        } else {
+            level.volume = 0;
+            clearBit(index);
+        }
+
+        total_volume_ += level.volume - old_volume;
+        depth_.add(index, level.volume - old_volume);
+    }
+
+    int volumeAt(int price) const {
+        const Level* level = find(price);
+        return level ? level->volume : 0;
+    }
+
+    // 价格不高于 price 的总挂单量
+    long long volumeAtOrBelow(int price) const {
+        if (levels_.empty() || price < base_price_) {
+            return 0;
+        }
+        return depth_.prefixSum(static_cast<size_t>((price - base_price_) / tick_));
+    }
+
+    // 价格不低于 price 的总挂单量
+    long long volumeAtOrAbove(int price) const {
+        return total_volume_ - volumeAtOrBelow(price - 1);
+    }
+
+    // 价格在 [low_price, high_price] 内的总挂单量
+    long long volumeBetween(int low_price, int high_price) const {
+        if (high_price < low_price) {
+            return 0;
+        }
+        return volumeAtOrBelow(high_price) - volumeAtOrBelow(low_price - 1);
+    }
+
+    long long totalVolume() const { return total_volume_; }
+
+    bool empty() const { return active_levels_ == 0; }
+
+    // 有量的档位数
+    size_t activeLevels() const { return active_levels_; }
+
+    // 有量的最低价, 没有时返回 kInvalidPrice
+    int lowestPrice() const {
+        return priceOf(firstFrom(0));
+    }
+
+    // 有量的最高价, 没有时返回 kInvalidPrice
+    int highestPrice() const {
+        return levels_.empty() ? kInvalidPrice : priceOf(lastFrom(levels_.size() - 1));
+    }
+
+    // 严格高于 price 的最低有量价格
+    int nextHigher(int price) const {
+        if (price < base_price_) {
+            return lowestPrice();
+        }
+        return priceOf(firstFrom(static_cast<size_t>((price - base_price_) / tick_) + 1));
+    }
+
+    // 严格低于 price 的最高有量价格
+    int nextLower(int price) const {
+        if (price <= base_price_ || levels_.empty()) {
+            return kInvalidPrice;
+        }
+        size_t index = static_cast<size_t>((price - base_price_ + tick_ - 1) / tick_) - 1;
+        return priceOf(lastFrom(std::min(index, levels_.size() - 1)));
+    }
+
+    // 全部档位(含无量档位), 下标对应价格 base_price() + i * tick()
+    const std::vector<Level>& levels() const { return levels_; }
+    int basePrice() const { return base_price_; }
+    int tick() const { return tick_; }
+
+private:
+    static constexpr size_t kNoIndex = static_cast<size_t>(-1);
+
+    bool indexOf(int price, size_t& index) const {
+        if (levels_.empty() || price < base_price_) {
+            return false;
+        }
+        int offset = price - base_price_;
+        if (offset % tick_ != 0) {
+            return false;
+        }
+        index = static_cast<size_t>(offset / tick_);
+        return index < levels_.size();
+    }
+
+    int priceOf(size_t index) const {
+        return index == kNoIndex ? kInvalidPrice : base_price_ + static_cast<int>(index) * tick_;
+    }
+
+    void setBit(size_t index) {
+        uint64_t& word = bits_[index >> 6];
+        uint64_t mask = uint64_t(1) << (index & 63);
+        if (word & mask) {
+            return;
+        }
+        if (word == 0) {
+            summary_[index >> 12] |= uint64_t(1) << ((index >> 6) & 63);
+        }
+        word |= mask;
+        ++active_levels_;
+    }
+
+    void clearBit(size_t index) {
+        uint64_t& word = bits_[index >> 6];
+        uint64_t mask = uint64_t(1) << (index & 63);
+        if (!(word & mask)) {
+            return;
+        }
+        word &= ~mask;
+        if (word == 0) {
+            summary_[index >> 12] &= ~(uint64_t(1) << ((index >> 6) & 63));
+        }
+        --active_levels_;
+    }
+
+    // 下标 >= index 的第一个有量档位
+    size_t firstFrom(size_t index) const {
+        size_t word_index = index >> 6;
+        if (word_index >= bits_.size()) {
+            return kNoIndex;
+        }
+
+        uint64_t word = bits_[word_index] & (~uint64_t(0) << (index & 63));
+        if (word) {
+            return (word_index << 6) + lowestSetBit(word);
+        }
+
+        // 当前字内没有, 在摘要位图中找下一个非空字
+        size_t next_word = word_index + 1;
+        size_t summary_index = next_word >> 6;
+        if (summary_index >= summary_.size()) {
+            return kNoIndex;
+        }
+        uint64_t summary = summary_[summary_index] & (~uint64_t(0) << (next_word & 63));
+        while (!summary) {
+            if (++summary_index >= summary_.size()) {
+                return kNoIndex;
+            }
+            summary = summary_[summary_index];
+        }
+
+        word_index = (summary_index << 6) + lowestSetBit(summary);
+        return (word_index << 6) + lowestSetBit(bits_[word_index]);
+    }
+
+    // 下标 <= index 的最后一个有量档位, index 须小于 levels_.size()
+    size_t lastFrom(size_t index) const {
+        size_t word_index = index >> 6;
+        uint64_t word = bits_[word_index] & (~uint64_t(0) >> (63 - (index & 63)));
+        if (word) {
+            return (word_index << 6) + highestSetBit(word);
+        }
+
+        if (word_index == 0) {
+            return kNoIndex;
+        }
+        size_t prev_word = word_index - 1;
+        size_t summary_index = prev_word >> 6;
+        uint64_t summary = summary_[summary_index] & (~uint64_t(0) >> (63 - (prev_word & 63)));
+        while (!summary) {
+            if (summary_index == 0) {
+                return kNoIndex;
+            }
+            summary = summary_[--summary_index];
+        }
+
+        word_index = (summary_index << 6) + highestSetBit(summary);
+        return (word_index << 6) + highestSetBit(bits_[word_index]);
+    }
+
+    // 扩展数组使 price 落在网格上
+    bool expandTo(int price) {
+        if (price <= 0) {
+            return false;
+        }
+
+        if (levels_.empty()) {
+            // 首个价格可能位于涨跌停区间内任意位置, 按 [price * (1 - p) / (1 + p), price * (1 + p) / (1 - p)] 取区间
+            long long low = static_cast<long long>(price) * (100 - auto_band_pct_) / (100 + auto_band_pct_);
+            long long high = static_cast<long long>(price) * (100 + auto_band_pct_) / (100 - auto_band_pct_);
+            int tick = (price % tick_ == 0) ? tick_ : std::gcd(tick_, price);
+            int base_price = static_cast<int>(low - low % tick);
+            return rebuild(base_price, tick, static_cast<size_t>((high - base_price) / tick) + 1);
+        }
+
+        int high_price = base_price_ + static_cast<int>(levels_.size() - 1) * tick_;
+        int tick = std::gcd(tick_, std::abs(price - base_price_));
+
+        // 向外多留半个当前区间, 避免价格逐档外移时反复重建
+        long long margin = std::max<long long>((static_cast<long long>(high_price) - base_price_) / 2, 64LL * tick);
+        long long low = std::min<long long>(base_price_, price < base_price_ ? price - margin : base_price_);
+        long long high = std::max<long long>(high_price, price > high_price ? price + margin : high_price);
+        if (low < 0) {
+            low = 0;
+        }
+
+        int base_price = base_price_ - static_cast<int>((base_price_ - low) / tick) * tick;
+        size_t count = static_cast<size_t>((high - base_price) / tick) + 1;
+        if (base_price == base_price_ && tick == tick_ && count == levels_.size()) {
+            return true;
+        }
+        return rebuild(base_price, tick, count);
+    }
+
+    // 按新的起始价/tick/档位数重建, 新网格须包含所有旧档位价格
+    bool rebuild(int base_price, int tick, size_t count) {
+        if (count == 0 || count > kMaxLevels) {
+            return false;
+        }
+
+        std::vector<Level> levels(count);
+        std::vector<uint64_t> bits((count + 63) >> 6, 0);
+        std::vector<uint64_t> summary((bits.size() + 63) >> 6, 0);
+        for (size_t i = 0; i < levels_.size(); ++i) {
+            size_t index = static_cast<size_t>((base_price_ + static_cast<int>(i) * tick_ - base_price) / tick);
+            levels[index] = std::move(levels_[i]);
+        }
+
+        levels_.swap(levels);
+        bits_.swap(bits);
+        summary_.swap(summary);
+        base_price_ = base_price;
+        tick_ = tick;
+        active_levels_ = 0;
+        for (size_t i = 0; i < levels_.size(); ++i) {
+            if (levels_[i].volume > 0) {
+                setBit(i);
+            }
+        }
+        depth_.reset(levels_, [](const Level& level) { return static_cast<long long>(level.volume); });
+        return true;
+    }
+
+    std::vector<Level> levels_;
+    std::vector<uint64_t> bits_;    // 第 i 位: 档位 i 有量
+    std::vector<uint64_t> summary_; // 第 i 位: bits_[i] 非 0
+    size_t active_levels_ = 0;
+    FenwickTree<long long> depth_;  // 各档挂单量的累计和, 下标同 levels_
+    long long total_volume_ = 0;
+
+    int base_price_ = 0;
+    int tick_;
+    int auto_band_pct_;
+};
@@ -0,0 +1,157 @@
+// QueuePositionTracker.h
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "FenwickTree.h"
+
+// 单个价位上指定挂单量订单的排队位置
+// 价位内订单按到达顺序编号(seq), 用树状数组维护各 seq 是否仍在队列中, 排位 = 不晚于自身的在队订单数;
+// 另为每个监控挂单量维护按 seq 有序的订单集合, 只保存监控挂单量的订单
+// 截止时间之后到达的订单不参与排位: 队列中第一个晚于截止时间的订单之后全部不计, 同样由树状数组定位
+// 增删改为 O(log n + log m), m 为同挂单量订单数; 读取为 O(k log n), k 为匹配订单数
+// seq 只增不回收, 已移除的 seq 过多时 needsCompaction() 成立, 由调用方 restart() 后按队列顺序重新 onAdd
+class QueuePositionTracker {
+public:
+    static constexpr uint32_t kUntracked = UINT32_MAX;
+    static constexpr size_t kCompactMinRemoved = 4096; // 触发重新编号的最少已移除 seq 数
+
+    // 开始跟踪 price 价位, 之后须按队列顺序对该价位已有订单调用 onAdd
+    void reset(int price, const std::vector<int>& monitor_volumes, int time_cutoff) {
+        price_ = price;
+        time_cutoff_ = time_cutoff;
+        monitor_volumes_ = monitor_volumes;
+        restart();
+    }
+
+    // 保留价位与监控挂单量, 清空全部 seq, 之后须按队列顺序对该价位在队订单重新调用 onAdd
+    void restart() {
+        volumes_.clear();
+        late_flags_.clear();
+        present_.clear();
+        late_.clear();
+        removed_ = 0;
+        buckets_.clear();
+        for (int volume : monitor_volumes_) {
+            if (!findBucket(volume)) {
+                buckets_.emplace_back(volume, std::set<uint32_t>());
+            }
+        }
+
+        active_ = true;
+        changed_ = true;
+    }
+
+    // 已移除的 seq 超过阈值且多于在队订单, 各数组与树状数组应重新编号压缩
+    bool needsCompaction() const {
+        return removed_ >= kCompactMinRemoved && removed_ * 2 > volumes_.size();
+    }
+
+    // 停止跟踪, 调用方负责清除订单上保存的 seq
+    void deactivate() { active_ = false; }
+
+    bool tracking(int price) const { return active_ && price_ == price; }
+    bool active() const { return active_; }
+    int price() const { return price_; }
+    const std::vector<int>& monitorVolumes() const { return monitor_volumes_; }
+
+    // 新订单进入队尾, 返回 seq
+    uint32_t onAdd(int volume, int timestamp) {
+        uint32_t seq = static_cast<uint32_t>(volumes_.size());
+        bool late = timestamp > time_cutoff_;
+        volumes_.push_back(volume);
+        late_flags_.push_back(late ? 1 : 0);
+        present_.push_back(1);
+        late_.push_back(late ? 1 : 0);
+        if (auto* bucket = findBucket(volume)) {
+            bucket->emplace_hint(bucket->end(), seq);
+        }
+        changed_ = true;
+        return seq;
+    }
+
+    void onVolumeChange(uint32_t seq, int volume) {
+        int old_volume = volumes_[seq];
+        if (old_volume == volume) {
+            return;
+        }
+        eraseFromBucket(old_volume, seq);
+        insertIntoBucket(volume, seq);
+        volumes_[seq] = volume;
+        changed_ = true;
+    }
+
+    void onRemove(uint32_t seq) {
+        eraseFromBucket(volumes_[seq], seq);
+        present_.add(seq, -1);
+        if (late_flags_[seq]) {
+            late_.add(seq, -1);
+        }
+        ++removed_;
+        changed_ = true;
+    }
+
+    // 自上次 collect 后排位是否可能变化
+    bool changed() const { return changed_; }
+
+    // 按监控挂单量的顺序输出各自的排位(从 1 开始)
+    void collect(std::vector<std::vector<int>>& positions) {
+        // 第一个晚于截止时间的在队订单, 其后订单不计
+        uint32_t first_late = static_cast<uint32_t>(late_.lowerBound(1));
+
+        positions.resize(monitor_volumes_.size());
+        for (size_t i = 0; i < monitor_volumes_.size(); ++i) {
+            positions[i].clear();
+            const std::set<uint32_t>* bucket = findBucket(monitor_volumes_[i]);
+            for (uint32_t seq : *bucket) {
+                if (seq >= first_late) {
+                    break;
+                }
+                positions[i].push_back(static_cast<int>(present_.prefixSum(seq)));
+            }
+        }
+        changed_ = false;
+    }
+
+private:
+    std::set<uint32_t>* findBucket(int volume) {
+        for (auto& bucket : buckets_) {
+            if (bucket.first == volume) {
+                return &bucket.second;
+            }
+        }
+        return nullptr;
+    }
+
+    const std::set<uint32_t>* findBucket(int volume) const {
+        return const_cast<QueuePositionTracker*>(this)->findBucket(volume);
+    }
+
+    void eraseFromBucket(int volume, uint32_t seq) {
+        if (auto* bucket = findBucket(volume)) {
+            bucket->erase(seq);
+        }
+    }
+
+    void insertIntoBucket(int volume, uint32_t seq) {
+        if (auto* bucket = findBucket(volume)) {
+            bucket->insert(seq);
+        }
+    }
+
+    bool active_ = false;
+    bool changed_ = false;
+    int price_ = 0;
+    int time_cutoff_ = 0;
+    std::vector<int> monitor_volumes_;
+
+    std::vector<int> volumes_;      // seq -> 当前挂单量
+    std::vector<uint8_t> late_flags_; // seq -> 是否晚于截止时间
+    FenwickTree<int> present_;      // seq 是否仍在队列中
+    FenwickTree<int> late_;         // seq 在队且晚于截止时间
+    size_t removed_ = 0;            // 已移除的 seq 数
+    std::vector<std::pair<int, std::set<uint32_t>>> buckets_; // 监控挂单量 -> 按 seq 有序的订单
+};
@@ -4,10 +4,14 @@
 #include <atomic>
 #include <windows.h>
 
+#include "ThreadConfig.h"
+
 class SendServer {
 public:
+    // role 为管道线程的核心绑定
     explicit SendServer(
-        const std::string& pipe_name
+        const std::string& pipe_name,
+        const ThreadRole& role = ThreadRole{}
     );
     ~SendServer();
 
@@ -17,6 +21,7 @@ public:
 
 private:
     std::string full_pipe_name_;
+    ThreadRole role_;
     std::thread server_thread_;
     std::atomic<bool> running_{true};
     HANDLE client_handle_ = INVALID_HANDLE_VALUE;
@@ -0,0 +1,72 @@
+// SeqLockSlot.h
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "WaitStrategy.h" // cpuRelax
+
+// 单写多读的顺序锁槽位, 存放一个可平凡复制的值
+// 写线程 publish() 不等待读者; 读线程 read() 复制一份完整的值, 遇到并发写入时重读,
+// 任何一方都不加锁. 内容按 8 字节原子字逐字复制, 并发读写不构成数据竞争
+template<typename T>
+class SeqLockSlot {
+    static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable");
+
+public:
+    SeqLockSlot() {
+        publish(T{});
+    }
+
+    SeqLockSlot(const SeqLockSlot&) = delete;
+    SeqLockSlot& operator=(const SeqLockSlot&) = delete;
+
+    // 写线程: 发布新值, 只允许一个写线程
+    void publish(const T& value) {
+        uint64_t words[kWords] = {};
+        std::memcpy(words, &value, sizeof(T));
+
+        uint64_t seq = seq_.load(std::memory_order_relaxed);
+        seq_.store(seq + 1, std::memory_order_relaxed); // 奇数: 写入中
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < kWords; ++i) {
+            words_[i].store(words[i], std::memory_order_relaxed);
+        }
+        seq_.store(seq + 2, std::memory_order_release);
+    }
+
+    // 读线程: 取得最近一次发布的完整值
+    T read() const {
+        uint64_t words[kWords];
+        while (true) {
+            uint64_t begin = seq_.load(std::memory_order_acquire);
+            if (begin & 1) {
+                cpuRelax();
+                continue;
+            }
+            for (size_t i = 0; i < kWords; ++i) {
+                words[i] = words_[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (seq_.load(std::memory_order_relaxed) == begin) {
+                break;
+            }
+        }
+
+        T value;
+        std::memcpy(&value, words, sizeof(T));
+        return value;
+    }
+
+    // 已发布的次数
+    uint64_t version() const {
+        return seq_.load(std::memory_order_acquire) >> 1;
+    }
+
+private:
+    static constexpr size_t kWords = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    std::atomic<uint64_t> seq_{0};
+    std::atomic<uint64_t> words_[kWords];
+};
@@ -0,0 +1,62 @@
+// ShardWorkerPool.h
+#pragma once
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "concurrentqueue/concurrentqueue.h"
+#include "SymbolTable.h"
+#include "ThreadConfig.h"
+#include "WaitStrategy.h"
+
+class OrderBookBase;
+
+// 有待处理事件的 OrderBook 队列, 每个处理线程一个
+// OrderBook 收到事件后把自身放入所属线程的队列(已在队列中时不重复放入), 处理线程按到达顺序轮流处理
+struct BookReadyQueue {
+    moodycamel::ConcurrentQueue<OrderBookBase*> books;
+    WaitStrategy waiter;
+
+    void push(OrderBookBase* book) {
+        books.enqueue(book);
+        waiter.notify();
+    }
+};
+
+// 固定数量的 OrderBook 处理线程
+// 每个 OrderBook 按 SymbolId 分配给一个处理线程, 之后只在该线程上处理, 同一合约的事件顺序不变;
+// OrderBook 自身不再持有线程, 由处理线程调用 poll() 推进
+// OrderBook 须在 stop() 之后才能析构
+class ShardWorkerPool {
+public:
+    // role 提供处理线程的核心绑定与等待方式, 第 i 个线程绑定 role.cores 中第 i 个核心
+    ShardWorkerPool(size_t worker_count, const ThreadRole& role);
+    ~ShardWorkerPool();
+
+    ShardWorkerPool(const ShardWorkerPool&) = delete;
+    ShardWorkerPool& operator=(const ShardWorkerPool&) = delete;
+
+    // 把 book 交给 symbol_id 对应的处理线程
+    void attach(OrderBookBase* book, SymbolId symbol_id);
+    void stop();
+
+    size_t workerCount() const { return workers_.size(); }
+
+private:
+    struct Worker {
+        size_t index = 0;
+        BookReadyQueue ready;
+        std::mutex books_mtx;
+        std::vector<OrderBookBase*> books; // 归属本线程的全部 OrderBook, 用于定时任务
+        std::thread thread;
+    };
+
+    void run(Worker& worker);
+
+    ThreadRole role_;
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::atomic<bool> running_{true};
+};
@@ -0,0 +1,130 @@
+// SlabArena.h
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// 空槽位号, 表示链表结束/无效节点
+constexpr uint32_t kNullSlot = UINT32_MAX;
+
+// 定长节点池
+// 节点按块(2^kChunkShift 个)分配, 扩容只追加新块, 已分配节点地址与槽位号始终不变;
+// 释放的槽位通过节点自身的 next 字段串成空闲链表, 下次分配优先复用, 预热后分配/释放不再触发堆分配
+// T 须为可平凡复制类型, 且含 uint32_t next 成员
+template<typename T, size_t kChunkShift = 12>
+class SlabArena {
+public:
+    static constexpr size_t kChunkSize = size_t(1) << kChunkShift;
+
+    struct Stats {
+        size_t capacity = 0;          // 已分配槽位总数
+        size_t live = 0;              // 使用中的槽位数
+        size_t peak = 0;              // 使用中槽位数峰值
+        size_t chunk_allocations = 0; // 分配块的次数, 预热后应不再增长
+    };
+
+    explicit SlabArena(size_t initial_capacity = kChunkSize) {
+        reserve(initial_capacity);
+    }
+
+    SlabArena(const SlabArena&) = delete;
+    SlabArena& operator=(const SlabArena&) = delete;
+
+    // 取一个空闲槽位, 节点内容未初始化
+    uint32_t allocate() {
+        if (free_head_ == kNullSlot) {
+            addChunk();
+        }
+
+        uint32_t slot = free_head_;
+        free_head_ = (*this)[slot].next;
+        ++stats_.live;
+        if (stats_.live > stats_.peak) {
+            stats_.peak = stats_.live;
+        }
+        return slot;
+    }
+
+    void release(uint32_t slot) {
+        (*this)[slot].next = free_head_;
+        free_head_ = slot;
+        --stats_.live;
+    }
+
+    T& operator[](uint32_t slot) {
+        return chunks_[slot >> kChunkShift][slot & (kChunkSize - 1)];
+    }
+
+    const T& operator[](uint32_t slot) const {
+        return chunks_[slot >> kChunkShift][slot & (kChunkSize - 1)];
+    }
+
+    // 预分配至少 capacity 个槽位
+    void reserve(size_t capacity) {
+        while (stats_.capacity < capacity) {
+            addChunk();
+        }
+    }
+
+    const Stats& stats() const { return stats_; }
+
+private:
+    void addChunk() {
+        const uint32_t first_slot = static_cast<uint32_t>(chunks_.size() << kChunkShift);
+        chunks_.push_back(std::make_unique<T[]>(kChunkSize));
+
+        // 新块槽位按升序接到空闲链表头部
+        T* chunk = chunks_.back().get();
+        for (size_t i = 0; i + 1 < kChunkSize; ++i) {
+            chunk[i].next = first_slot + static_cast<uint32_t>(i + 1);
+        }
+        chunk[kChunkSize - 1].next = free_head_;
+        free_head_ = first_slot;
+
+        stats_.capacity += kChunkSize;
+        ++stats_.chunk_allocations;
+    }
+
+    std::vector<std::unique_ptr<T[]>> chunks_;
+    uint32_t free_head_ = kNullSlot;
+    Stats stats_;
+};
+
+// 槽位号串成的双向 FIFO 链表, 节点存放在 SlabArena 中, 须含 uint32_t prev/next 成员
+// 只保存头尾槽位号, 可平凡复制, 移动后节点槽位号不变
+struct IntrusiveFifo {
+    uint32_t head = kNullSlot;
+    uint32_t tail = kNullSlot;
+
+    bool empty() const { return head == kNullSlot; }
+
+    template<typename Arena>
+    void push_back(Arena& arena, uint32_t slot) {
+        auto& node = arena[slot];
+        node.prev = tail;
+        node.next = kNullSlot;
+        if (tail == kNullSlot) {
+            head = slot;
+        } else {
+            arena[tail].next = slot;
+        }
+        tail = slot;
+    }
+
+    // slot 须在本链表中
+    template<typename Arena>
+    void erase(Arena& arena, uint32_t slot) {
+        auto& node = arena[slot];
+        if (node.prev == kNullSlot) {
+            head = node.next;
+        } else {
+            arena[node.prev].next = node.next;
+        }
+        if (node.next == kNullSlot) {
+            tail = node.prev;
+        } else {
+            arena[node.next].prev = node.prev;
+        }
+    }
+};
@@ -0,0 +1,132 @@
+// SlidingWindowAggregator.h
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+// 窗口聚合运算, identity() 为空窗口的结果, 运算须满足结合律
+template<typename T>
+struct WindowMax {
+    static T identity() { return std::numeric_limits<T>::lowest(); }
+    T operator()(const T& a, const T& b) const { return std::max(a, b); }
+};
+
+template<typename T>
+struct WindowMin {
+    static T identity() { return std::numeric_limits<T>::max(); }
+    T operator()(const T& a, const T& b) const { return std::min(a, b); }
+};
+
+template<typename T>
+struct WindowSum {
+    static T identity() { return T(); }
+    T operator()(const T& a, const T& b) const { return a + b; }
+};
+
+// 按事件时间滑动的窗口聚合(最大/最小/求和, 计数即 size())
+// 双栈法: 窗口元素按时间顺序存放在环形缓冲区中, 以 split_ 为界,
+//   前段每个元素保存"自身到前段末尾"的聚合值, 后段只保存一个整体聚合值 back_agg_;
+//   出窗时前段为空则把整个窗口转入前段, 每个元素至多转入一次, 入窗/出窗/查询均摊 O(1)
+// 缓冲区容量为 2 的幂, 满时翻倍, 窗口规模稳定后不再分配内存
+// 时间须单调不减, 早于队尾的时间按队尾时间计(实时行情偶有乱序, 最多晚出窗一个乱序间隔)
+template<typename T, typename Op = WindowMax<T>>
+class SlidingWindowAggregator {
+public:
+    explicit SlidingWindowAggregator(size_t initial_capacity = 1024) {
+        size_t capacity = 1;
+        while (capacity < initial_capacity) {
+            capacity <<= 1;
+        }
+        times_.resize(capacity);
+        values_.resize(capacity);
+        aggs_.resize(capacity);
+        mask_ = capacity - 1;
+    }
+
+    void push(int time, const T& value) {
+        if (tail_ - head_ == times_.size()) {
+            grow();
+        }
+        if (tail_ != head_ && time < times_[(tail_ - 1) & mask_]) {
+            time = times_[(tail_ - 1) & mask_];
+        }
+
+        times_[tail_ & mask_] = time;
+        values_[tail_ & mask_] = value;
+        back_agg_ = (tail_ == split_) ? value : op_(back_agg_, value);
+        ++tail_;
+    }
+
+    // 移出时间 <= cutoff 的元素
+    void evictUpTo(int cutoff) {
+        while (head_ != tail_ && times_[head_ & mask_] <= cutoff) {
+            if (head_ == split_) {
+                flip();
+            }
+            ++head_;
+        }
+    }
+
+    // 窗口内全部元素的聚合值, 空窗口返回 Op::identity()
+    T query() const {
+        if (head_ == split_) {
+            return (split_ == tail_) ? Op::identity() : back_agg_;
+        }
+        return (split_ == tail_) ? aggs_[head_ & mask_] : op_(aggs_[head_ & mask_], back_agg_);
+    }
+
+    size_t size() const { return static_cast<size_t>(tail_ - head_); }
+    bool empty() const { return head_ == tail_; }
+    size_t capacity() const { return times_.size(); }
+
+    void clear() {
+        head_ = split_ = tail_ = 0;
+    }
+
+private:
+    // 后段整体转入前段, 从后往前计算后缀聚合值
+    void flip() {
+        T agg = values_[(tail_ - 1) & mask_];
+        aggs_[(tail_ - 1) & mask_] = agg;
+        for (uint64_t i = tail_ - 1; i-- > head_;) {
+            agg = op_(values_[i & mask_], agg);
+            aggs_[i & mask_] = agg;
+        }
+        split_ = tail_;
+    }
+
+    void grow() {
+        const size_t count = size();
+        const size_t capacity = times_.size() * 2;
+        std::vector<int> times(capacity);
+        std::vector<T> values(capacity);
+        std::vector<T> aggs(capacity);
+        for (size_t i = 0; i < count; ++i) {
+            times[i] = times_[(head_ + i) & mask_];
+            values[i] = values_[(head_ + i) & mask_];
+            aggs[i] = aggs_[(head_ + i) & mask_];
+        }
+        times_.swap(times);
+        values_.swap(values);
+        aggs_.swap(aggs);
+        mask_ = capacity - 1;
+
+        split_ -= head_;
+        tail_ = count;
+        head_ = 0;
+    }
+
+    std::vector<int> times_;
+    std::vector<T> values_;
+    std::vector<T> aggs_;   // 前段 [head_, split_) 的后缀聚合值
+    size_t mask_ = 0;
+
+    // 单调递增的逻辑下标, 取模后为缓冲区位置
+    uint64_t head_ = 0;
+    uint64_t split_ = 0;
+    uint64_t tail_ = 0;
+    T back_agg_ = T();      // 后段 [split_, tail_) 的聚合值
+    Op op_;
+};
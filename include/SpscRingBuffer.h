@@ -0,0 +1,114 @@
+// SpscRingBuffer.h
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+// 缓存行大小, 用于隔离生产者/消费者各自频繁写入的字段, 避免伪共享
+constexpr size_t kCacheLineSize = 64;
+
+// 单生产者单消费者环形缓冲区
+// 容量向上取整为 2 的幂, 下标用掩码取模; head_/tail_ 单调递增, 各占一条缓存行,
+// 双方各自缓存对端位置, 只有缓存值显示空间/数据不足时才去读对端的原子变量;
+// 批量接口整批写入/取出后只发布一次 tail_/head_
+// 只负责无锁存取, 不负责等待唤醒, 由使用方配合 WaitStrategy 使用
+template<typename T>
+class SpscRingBuffer {
+public:
+    explicit SpscRingBuffer(size_t capacity)
+        : capacity_(roundUpPowerOfTwo(std::max<size_t>(capacity, 2))),
+          mask_(capacity_ - 1),
+          slots_(std::make_unique<T[]>(capacity_)) {}
+
+    SpscRingBuffer(const SpscRingBuffer&) = delete;
+    SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+
+    // 生产者: 写入一个元素, 队列满时返回 false
+    bool try_push(T item) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_cache_ == capacity_) {
+            head_cache_ = head_.load(std::memory_order_acquire);
+            if (tail - head_cache_ == capacity_) {
+                return false;
+            }
+        }
+        slots_[tail & mask_] = std::move(item);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 生产者: 尽量写入 count 个元素, 返回实际写入数
+    size_t try_push_bulk(const T* items, size_t count) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        size_t free_slots = capacity_ - (tail - head_cache_);
+        if (free_slots < count) {
+            head_cache_ = head_.load(std::memory_order_acquire);
+            free_slots = capacity_ - (tail - head_cache_);
+        }
+
+        const size_t n = std::min(count, free_slots);
+        for (size_t i = 0; i < n; ++i) {
+            slots_[(tail + i) & mask_] = items[i];
+        }
+        if (n > 0) {
+            tail_.store(tail + n, std::memory_order_release);
+        }
+        return n;
+    }
+
+    // 消费者: 最多取出 max_count 个元素, 返回实际取出数
+    size_t try_pop_bulk(T* out, size_t max_count) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        size_t available = tail_cache_ - head;
+        // 缓存值不够一整批时重读 tail_: 调用方按"取不满一批即已取空"判断有无积压,
+        // 只按缓存值取出会漏掉已发布的数据, 而生产者此时可能不会再次唤醒消费者
+        if (available < max_count) {
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            available = tail_cache_ - head;
+        }
+
+        const size_t n = std::min(available, max_count);
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = std::move(slots_[(head + i) & mask_]);
+        }
+        if (n > 0) {
+            head_.store(head + n, std::memory_order_release);
+        }
+        return n;
+    }
+
+    // 消费者侧判断是否有数据可取
+    bool empty() const {
+        return head_.load(std::memory_order_relaxed) == tail_.load(std::memory_order_acquire);
+    }
+
+    size_t size_approx() const {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+
+    size_t capacity() const { return capacity_; }
+
+private:
+    static size_t roundUpPowerOfTwo(size_t n) {
+        size_t value = 1;
+        while (value < n) {
+            value <<= 1;
+        }
+        return value;
+    }
+
+    // 消费者独占的缓存行
+    alignas(kCacheLineSize) std::atomic<size_t> head_{0};
+    size_t tail_cache_ = 0;
+
+    // 生产者独占的缓存行
+    alignas(kCacheLineSize) std::atomic<size_t> tail_{0};
+    size_t head_cache_ = 0;
+
+    // 只读字段
+    alignas(kCacheLineSize) const size_t capacity_;
+    const size_t mask_;
+    std::unique_ptr<T[]> slots_;
+};
@@ -0,0 +1,105 @@
+// SwarDecoder.h
+#pragma once
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#include "DataStruct.h"
+
+// SWAR (SIMD within a register) 定长数字解析
+// 把最多 8 个 ASCII 数字装进一个 64 位字, 一次校验 + 三次乘法得到整数值, 无逐字节循环与分支;
+// 只有非数字/超长/负数等异常输入才走 svToInt / svToLong 慢路径, 并沿用其 LOG_WARN 告警
+// 假定小端字节序(x86 / ARM), 字节 0 对应字符串首字符即最高位
+
+// 把 1~8 个数字右对齐装入 64 位字, 高位补 '0'
+inline uint64_t swarLoadDigits(const char* p, size_t len) {
+    uint64_t word = 0x3030303030303030ULL;
+    std::memcpy(reinterpret_cast<char*>(&word) + (8 - len), p, len);
+    return word;
+}
+
+// 8 个字节是否全是 '0'~'9'
+inline bool swarIsEightDigits(uint64_t word) {
+    return (((word & 0xF0F0F0F0F0F0F0F0ULL) |
+             (((word + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) ==
+            0x3333333333333333ULL);
+}
+
+// 8 个数字字符转为整数
+inline uint32_t swarEightDigitsToInt(uint64_t word) {
+    word -= 0x3030303030303030ULL;
+    word = (word * 10) + (word >> 8); // 相邻两位合并
+    word = (((word & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) +
+            (((word >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >> 32;
+    return static_cast<uint32_t>(word);
+}
+
+// 解析 1~16 位无符号十进制数, 非法输入返回 false
+inline bool swarParseUnsigned(std::string_view sv, uint64_t& out) {
+    const size_t len = sv.size();
+    if (len == 0 || len > 16) {
+        return false;
+    }
+
+    if (len <= 8) {
+        uint64_t word = swarLoadDigits(sv.data(), len);
+        if (!swarIsEightDigits(word)) return false;
+        out = swarEightDigitsToInt(word);
+        return true;
+    }
+
+    uint64_t high = swarLoadDigits(sv.data(), len - 8);
+    uint64_t low;
+    std::memcpy(&low, sv.data() + len - 8, 8);
+    if (!swarIsEightDigits(high) || !swarIsEightDigits(low)) return false;
+
+    out = static_cast<uint64_t>(swarEightDigitsToInt(high)) * 100000000ULL + swarEightDigitsToInt(low);
+    return true;
+}
+
+// svToInt 的快速版本: 价格, 数量, 编号等非负整数字段
+inline int swarSvToInt(std::string_view sv) {
+    uint64_t value;
+    if (sv.size() <= 10 && swarParseUnsigned(sv, value) && value <= static_cast<uint64_t>(INT_MAX)) {
+        return static_cast<int>(value);
+    }
+    return svToInt(sv);
+}
+
+// svToLong 的快速版本: 成交金额等字段
+inline long long swarSvToLong(std::string_view sv) {
+    uint64_t value;
+    if (swarParseUnsigned(sv, value)) {
+        return static_cast<long long>(value);
+    }
+    return svToLong(sv);
+}
+
+// HHMMSSmmm (小时不足两位时为 8 位) 解析, 解析数字的同时换算出当日毫秒时间戳, 无除法与取模
+inline void swarSvToTime(std::string_view sv, int& time, int& timestamp) {
+    const size_t len = sv.size();
+    if (len == 8 || len == 9) {
+        // 前 8 位按 HH MM SS m m 两两成对, 最后一位单独处理
+        uint64_t word = 0x3030303030303030ULL;
+        std::memcpy(reinterpret_cast<char*>(&word) + (9 - len), sv.data(), len - 1);
+        const unsigned last = static_cast<unsigned>(sv[len - 1]) - '0';
+
+        if (swarIsEightDigits(word) && last <= 9) {
+            word -= 0x3030303030303030ULL;
+            word = (word * 10) + (word >> 8); // 字节 0/2/4/6 分别为 HH, MM, SS, 毫秒的前两位
+
+            const int hour   = static_cast<int>(word & 0xFF);
+            const int minute = static_cast<int>((word >> 16) & 0xFF);
+            const int second = static_cast<int>((word >> 32) & 0xFF);
+            const int millis = static_cast<int>((word >> 48) & 0xFF) * 10 + static_cast<int>(last);
+
+            time = ((hour * 100 + minute) * 100 + second) * 1000 + millis;
+            timestamp = ((hour * 60 + minute) * 60 + second) * 1000 + millis;
+            return;
+        }
+    }
+
+    time = svToInt(sv);
+    timestamp = timeIntToMs(time);
+}
@@ -0,0 +1,150 @@
+// SymbolTable.h
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string_view>
+
+#include "Logger.h"
+
+// 合约代码的紧凑编号, 在进程内从 0 开始连续分配, 可直接作为数组下标
+using SymbolId = uint32_t;
+constexpr SymbolId kInvalidSymbolId = UINT32_MAX;
+
+// 全局合约代码驻留表: "600895.SH" 等交易所代码 <--> SymbolId
+// 查找无锁(开放寻址 + 原子发布), 只有首次出现的新代码才会加锁插入;
+// 编号一经分配在进程生命周期内不变, 不支持删除
+class SymbolTable {
+public:
+    static constexpr size_t kMaxSymbols = 16384;   // 最多驻留的合约数
+    static constexpr size_t kMaxSymbolLength = 15; // 合约代码最大长度
+
+    static SymbolTable& instance() {
+        static SymbolTable table;
+        return table;
+    }
+
+    // 查找或分配编号, 代码为空/过长或表已满时返回 kInvalidSymbolId
+    SymbolId intern(std::string_view code) {
+        const uint64_t hash = hashCode(code);
+        SymbolId id = lookup(code, hash);
+        if (id != kInvalidSymbolId) {
+            return id;
+        }
+        return insert(code, hash);
+    }
+
+    // 只查找不分配, 不存在时返回 kInvalidSymbolId
+    SymbolId find(std::string_view code) const {
+        return lookup(code, hashCode(code));
+    }
+
+    // 编号对应的合约代码, 非法编号返回空串
+    std::string_view name(SymbolId id) const {
+        if (id >= size_.load(std::memory_order_acquire)) {
+            return {};
+        }
+        const Entry& entry = entries_[id];
+        return std::string_view(entry.code, entry.length);
+    }
+
+    // 已分配的编号数, 编号范围为 [0, size())
+    size_t size() const {
+        return size_.load(std::memory_order_acquire);
+    }
+
+private:
+    static constexpr size_t kSlotCount = kMaxSymbols * 2; // 装载因子不超过 0.5
+    static_assert((kSlotCount & (kSlotCount - 1)) == 0, "槽位数必须是 2 的幂");
+
+    struct Entry {
+        char code[kMaxSymbolLength + 1];
+        uint8_t length;
+    };
+
+    struct Slot {
+        std::atomic<SymbolId> id{kInvalidSymbolId};
+        uint64_t hash = 0; // 在 id 发布前写入
+    };
+
+    SymbolTable()
+        : entries_(std::make_unique<Entry[]>(kMaxSymbols)),
+          slots_(std::make_unique<Slot[]>(kSlotCount)) {}
+
+    SymbolTable(const SymbolTable&) = delete;
+    SymbolTable& operator=(const SymbolTable&) = delete;
+
+    // FNV-1a
+    static uint64_t hashCode(std::string_view code) {
+        uint64_t hash = 1469598103934665603ULL;
+        for (char c : code) {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    bool matches(SymbolId id, std::string_view code) const {
+        const Entry& entry = entries_[id];
+        return entry.length == code.size() && std::memcmp(entry.code, code.data(), code.size()) == 0;
+    }
+
+    SymbolId lookup(std::string_view code, uint64_t hash) const {
+        size_t slot = static_cast<size_t>(hash) & (kSlotCount - 1);
+        while (true) {
+            SymbolId id = slots_[slot].id.load(std::memory_order_acquire);
+            if (id == kInvalidSymbolId) {
+                return kInvalidSymbolId;
+            }
+            if (slots_[slot].hash == hash && matches(id, code)) {
+                return id;
+            }
+            slot = (slot + 1) & (kSlotCount - 1);
+        }
+    }
+
+    SymbolId insert(std::string_view code, uint64_t hash) {
+        if (code.empty() || code.size() > kMaxSymbolLength) {
+            LOG_WARN("SymbolTable", "合约代码长度非法: {}", code);
+            return kInvalidSymbolId;
+        }
+
+        std::lock_guard<std::mutex> lock(mtx_);
+
+        // 加锁后重新查找, 可能已被其他线程插入
+        size_t slot = static_cast<size_t>(hash) & (kSlotCount - 1);
+        while (true) {
+            SymbolId id = slots_[slot].id.load(std::memory_order_relaxed);
+            if (id == kInvalidSymbolId) {
+                break;
+            }
+            if (slots_[slot].hash == hash && matches(id, code)) {
+                return id;
+            }
+            slot = (slot + 1) & (kSlotCount - 1);
+        }
+
+        const SymbolId id = static_cast<SymbolId>(size_.load(std::memory_order_relaxed));
+        if (id >= kMaxSymbols) {
+            LOG_ERROR("SymbolTable", "合约代码驻留表已满({}), 无法加入: {}", kMaxSymbols, code);
+            return kInvalidSymbolId;
+        }
+
+        Entry& entry = entries_[id];
+        std::memcpy(entry.code, code.data(), code.size());
+        entry.code[code.size()] = '\0';
+        entry.length = static_cast<uint8_t>(code.size());
+
+        size_.store(id + 1, std::memory_order_release);
+        slots_[slot].hash = hash;
+        slots_[slot].id.store(id, std::memory_order_release);
+        return id;
+    }
+
+    std::unique_ptr<Entry[]> entries_;
+    std::unique_ptr<Slot[]> slots_;
+    std::atomic<size_t> size_{0};
+    std::mutex mtx_;
+};
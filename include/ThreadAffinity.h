@@ -0,0 +1,100 @@
+// ThreadAffinity.h
+#pragma once
+#include <cctype>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// 核心列表 "2,3,6-9" --> {2, 3, 6, 7, 8, 9}
+// 核心号上限为 std::thread::hardware_concurrency() - 1, 区间超出部分截断;
+// 无法识别的项、负数、超出上限的核心号与被截断的区间不计入结果, 原文追加到 rejected(非空时), 由调用方打日志
+inline std::vector<int> parseCoreList(const std::string& text, std::vector<std::string>* rejected = nullptr) {
+    const unsigned hardware_cores = std::thread::hardware_concurrency();
+    const int max_core = static_cast<int>(hardware_cores > 0 ? hardware_cores : 1024) - 1;
+
+    auto parse_int = [](const std::string& item, int& value) {
+        size_t used = 0;
+        try {
+            value = std::stoi(item, &used);
+        } catch (...) {
+            return false;
+        }
+        return used == item.size();
+    };
+
+    std::vector<int> cores;
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t end = text.find(',', pos);
+        if (end == std::string::npos) end = text.size();
+        std::string item = text.substr(pos, end - pos);
+        pos = end + 1;
+
+        item.erase(0, item.find_first_not_of(" \t"));
+        item.erase(item.find_last_not_of(" \t") + 1);
+        if (item.empty()) {
+            continue;
+        }
+
+        size_t dash = item.find('-', 1);
+        int first = 0;
+        int last = 0;
+        bool valid = parse_int(item.substr(0, dash), first) &&
+            (dash == std::string::npos ? (last = first, true) : parse_int(item.substr(dash + 1), last));
+        if (!valid || first < 0 || first > last || first > max_core) {
+            if (rejected) rejected->push_back(item);
+            continue;
+        }
+
+        if (last > max_core) {
+            if (rejected) rejected->push_back(item + " 中超过 " + std::to_string(max_core) + " 的部分");
+            last = max_core;
+        }
+        for (int core = first; core <= last; ++core) {
+            cores.push_back(core);
+        }
+    }
+    return cores;
+}
+
+inline std::string coreListName(const std::vector<int>& cores) {
+    std::string name;
+    for (int core : cores) {
+        if (!name.empty()) name += ',';
+        name += std::to_string(core);
+    }
+    return name.empty() ? "-" : name;
+}
+
+// 把当前线程绑定到 cores 中的核心, cores 为空时不做任何事
+inline bool pinCurrentThread(const std::vector<int>& cores) {
+    if (cores.empty()) {
+        return true;
+    }
+
+#ifdef _WIN32
+    DWORD_PTR mask = 0;
+    for (int core : cores) {
+        if (core < static_cast<int>(sizeof(DWORD_PTR) * 8)) {
+            mask |= static_cast<DWORD_PTR>(1) << core;
+        }
+    }
+    return mask != 0 && SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+#else
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int core : cores) {
+        if (core < CPU_SETSIZE) {
+            CPU_SET(core, &set);
+        }
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#endif
+}
@@ -0,0 +1,87 @@
+// ThreadConfig.h
+#pragma once
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ConfigReader.h"
+#include "Logger.h"
+#include "ThreadAffinity.h"
+#include "WaitStrategy.h"
+
+// 一类线程的核心绑定与等待方式
+// 同一类有多个线程时(如 OrderBook 处理线程), pinThread(index) 依次分配列表中的核心, 一个线程独占一个核心;
+// 等待方式只对在队列上等待数据的线程(router / book)有效
+struct ThreadRole {
+    std::string name;
+    std::vector<int> cores;               // 空为不绑定
+    WaitMode wait_mode = WaitMode::BLOCK;
+    int spin_count = 4096;                // SPIN_THEN_PARK 挂起前的自旋次数
+
+    // 绑定到全部核心, 用于不在热路径上的线程
+    void pinThread() const {
+        pin(cores);
+    }
+
+    // 绑定到第 index 个核心(超出时回绕)
+    void pinThread(size_t index) const {
+        if (!cores.empty()) {
+            pin({cores[index % cores.size()]});
+        }
+    }
+
+private:
+    void pin(const std::vector<int>& target) const {
+        if (target.empty()) {
+            return;
+        }
+        if (pinCurrentThread(target)) {
+            LOG_INFO("ThreadConfig", "[{}] 线程绑定核心 {}", name, coreListName(target));
+        } else {
+            LOG_WARN("ThreadConfig", "[{}] 线程绑定核心 {} 失败", name, coreListName(target));
+        }
+    }
+};
+
+// 线程配置, 对应 config.ini 的 [threads] 段
+// 每类线程可配置 <name>_cores = 2,3,6-9 / <name>_wait = block|spin|busy_poll / <name>_spin = 自旋次数
+struct ThreadConfig {
+    int book_workers = 0; // OrderBook 处理线程数, 0 为按 CPU 核数的一半取值
+
+    ThreadRole recv;    // L2TcpSubscriber 接收线程
+    ThreadRole router;  // DataRouter 解析线程
+    ThreadRole book;    // OrderBook 处理线程
+    ThreadRole journal; // TickJournal 写盘线程
+    ThreadRole send;    // SendServer 管道线程
+    // spdlog 后台线程的 log_cores 在创建日志线程池时由 main 读取
+};
+
+inline ThreadRole loadThreadRole(const ConfigReader& config, const std::string& name, WaitMode default_wait) {
+    ThreadRole role;
+    role.name = name;
+    std::vector<std::string> rejected;
+    role.cores = parseCoreList(config.get("threads", name + "_cores"), &rejected);
+    for (const std::string& item : rejected) {
+        LOG_WARN("ThreadConfig", "[threads] {}_cores 中的 {} 无效, 已忽略", name, item);
+    }
+    role.wait_mode = parseWaitMode(config.get("threads", name + "_wait"), default_wait);
+    role.spin_count = std::max(1, config.getInt("threads", name + "_spin", role.spin_count));
+    return role;
+}
+
+// 未配置 <name>_wait 时使用 default_wait([pipeline] 段 wait_strategy)
+inline ThreadConfig loadThreadConfig(const ConfigReader& config, WaitMode default_wait = WaitMode::BLOCK) {
+    ThreadConfig threads;
+    threads.book_workers = config.getInt("threads", "book_workers", threads.book_workers);
+    if (threads.book_workers <= 0) {
+        threads.book_workers = std::max(1, static_cast<int>(std::thread::hardware_concurrency() / 2));
+    }
+
+    threads.recv = loadThreadRole(config, "recv", default_wait);
+    threads.router = loadThreadRole(config, "router", default_wait);
+    threads.book = loadThreadRole(config, "book", default_wait);
+    threads.journal = loadThreadRole(config, "journal", default_wait);
+    threads.send = loadThreadRole(config, "send", default_wait);
+    return threads;
+}
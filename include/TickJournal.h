@@ -0,0 +1,129 @@
+// TickJournal.h
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "concurrentqueue/blockingconcurrentqueue.h"
+#include "SymbolTable.h"
+#include "ThreadConfig.h"
+
+// 逐笔原始数据二进制日志
+// 每个会话一个目录, 目录下按序号滚动写入预分配的内存映射段文件 segment_000000.tj, segment_000001.tj ...
+// 段文件 = 段头 + 若干定长头部的变长记录, 记录负载为行情原始文本(不含推送帧的 '<' '#' '>');
+// SymbolId 只在进程内有效, 因此每个段内某合约首次出现前会先写一条合约定义记录, 单个段文件可独立解析
+//
+// 写入路径: 解析线程把记录追加进各自的 TickJournalBatch, 每个 TCP 分片提交一次,
+// 后台线程负责拷贝进映射内存, 解析线程上没有文件操作, 缓冲区循环复用
+
+struct TickJournalSegmentHeader {
+    char magic[4];            // "L2TJ"
+    uint32_t version;
+    uint32_t segment_index;
+    uint32_t header_bytes;    // 段头长度, 即第一条记录的偏移
+    int64_t created_time_us;  // 段创建时间, 自 1970-01-01 起的微秒
+    int64_t reserved;
+};
+
+struct TickJournalRecordHeader {
+    uint16_t length;          // 负载字节数, 0 表示段内记录结束
+    uint8_t stream;           // streamIndex(), kSymbolDefinition 表示合约定义记录
+    uint8_t reserved;
+    uint32_t symbol_id;       // 会话内 SymbolId
+    int64_t recv_time_us;     // 接收时间, 自 1970-01-01 起的微秒
+};
+
+static_assert(sizeof(TickJournalSegmentHeader) == 32, "段头布局变化会导致旧日志无法读取");
+static_assert(sizeof(TickJournalRecordHeader) == 16, "记录头布局变化会导致旧日志无法读取");
+
+// 解析线程侧的待提交记录, 二进制布局与段文件中的记录一致
+class TickJournalBatch {
+public:
+    void append(uint8_t stream, SymbolId symbol_id, int64_t recv_time_us, std::string_view text);
+
+    bool empty() const { return bytes_.empty(); }
+    size_t size() const { return bytes_.size(); }
+
+private:
+    friend class TickJournal;
+    std::string bytes_;
+};
+
+class TickJournal {
+public:
+    static constexpr uint32_t kVersion = 1;
+    static constexpr uint8_t kSymbolDefinition = 0xFF;
+
+    // 在 base_dir 下以当前时间创建会话目录
+    // role 为写盘线程的核心绑定
+    TickJournal(const std::string& base_dir, size_t segment_bytes, const ThreadRole& role = ThreadRole{});
+    ~TickJournal();
+
+    // 提交一批记录给后台线程, batch 被换成一个回收的空缓冲区, 可继续追加
+    void submit(TickJournalBatch& batch);
+
+    void stop();
+
+    const std::string& sessionDir() const { return session_dir_; }
+
+    static int64_t nowMicros();
+
+private:
+    class Segment;
+
+    void writerLoop();
+    void writeBlock(const std::string& block);
+    bool ensureSpace(size_t bytes);
+    void writeRecord(const TickJournalRecordHeader& header, const char* payload);
+    bool openSegment();
+    void closeSegment();
+
+    std::string session_dir_;
+    size_t segment_bytes_;
+
+    std::unique_ptr<Segment> segment_;
+    uint32_t segment_index_ = 0;
+    size_t write_offset_ = 0;
+    std::vector<uint8_t> defined_symbols_; // 当前段内已写过定义记录的 SymbolId
+
+    moodycamel::BlockingConcurrentQueue<std::string> pending_blocks_;
+    moodycamel::ConcurrentQueue<std::string> free_blocks_;
+
+    uint64_t record_count_ = 0;
+    uint64_t dropped_records_ = 0;
+
+    ThreadRole role_;
+    std::atomic<bool> running_{true};
+    std::thread writer_thread_;
+};
+
+// 日志读取
+class TickJournalReader {
+public:
+    struct Record {
+        uint8_t stream;
+        SymbolId symbol_id;     // 日志会话内的编号, 与当前进程的 SymbolTable 无关
+        std::string_view symbol;
+        int64_t recv_time_us;
+        std::string_view text;  // 原始文本, 仅在回调内有效
+    };
+
+    // session_dir 为 TickJournal::sessionDir() 目录
+    explicit TickJournalReader(const std::string& session_dir);
+
+    // 按写入顺序遍历所有数据记录, 返回记录数
+    size_t forEach(const std::function<void(const Record&)>& on_record);
+
+    const std::vector<std::string>& segmentFiles() const { return segment_files_; }
+
+private:
+    std::vector<std::string> segment_files_;
+};
+
+// 把日志转回原有的逐笔文本落盘格式: output_dir/<合约>_order_tcp.txt, output_dir/<合约>_trade_tcp.txt
+size_t convertTickJournalToText(const std::string& session_dir, const std::string& output_dir);
@@ -0,0 +1,107 @@
+// TripleBufferSlot.h
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+#include "WaitStrategy.h" // cpuRelax
+
+// 单写多读的多缓冲槽位, 用于发布较大的非平凡类型(如 vector<vector<int>>)
+// 读者 read() 得到一个句柄, 持有期间所指缓冲区被钉住, 写者不会改写它, 读者直接引用, 不复制;
+// 写者只写未被钉住且非最新的缓冲区, 发布时切换最新下标, 缓冲区循环复用, 容量保留
+// 读者持有句柄的时间应很短; 所有非最新缓冲区都被钉住时写者自旋等待
+template<typename T, size_t kBuffers = 3>
+class TripleBufferSlot {
+    static_assert(kBuffers >= 3, "at least one buffer must stay free for the writer");
+    static_assert(std::is_copy_assignable_v<T>, "T must be copy-assignable");
+    static_assert(std::is_default_constructible_v<T>, "T must be default-constructible");
+
+    struct Buffer {
+        T value{};
+        mutable std::atomic<int> pins{0};
+    };
+
+public:
+    // 钉住一个已发布缓冲区的只读句柄
+    class Handle {
+    public:
+        Handle(Handle&& other) noexcept : buffer_(other.buffer_) { other.buffer_ = nullptr; }
+        Handle& operator=(Handle&&) = delete;
+        Handle(const Handle&) = delete;
+        Handle& operator=(const Handle&) = delete;
+        ~Handle() {
+            if (buffer_) buffer_->pins.fetch_sub(1, std::memory_order_release);
+        }
+
+        const T& operator*() const { return buffer_->value; }
+        const T* operator->() const { return &buffer_->value; }
+
+    private:
+        friend class TripleBufferSlot;
+        explicit Handle(const Buffer* buffer) : buffer_(buffer) {}
+
+        const Buffer* buffer_;
+    };
+
+    TripleBufferSlot() = default;
+    TripleBufferSlot(const TripleBufferSlot&) = delete;
+    TripleBufferSlot& operator=(const TripleBufferSlot&) = delete;
+
+    // 读者: 钉住最新发布的缓冲区
+    // 先钉住再复查最新下标, 与写者先切换下标再检查钉住计数配对(均为 seq_cst),
+    // 两者至少有一方能看到对方, 写者不会选中正被读取的缓冲区
+    Handle read() const {
+        while (true) {
+            size_t index = latest_.load(std::memory_order_seq_cst);
+            const Buffer& buffer = buffers_[index];
+            buffer.pins.fetch_add(1, std::memory_order_seq_cst);
+            if (latest_.load(std::memory_order_seq_cst) == index) {
+                return Handle(&buffer);
+            }
+            buffer.pins.fetch_sub(1, std::memory_order_release);
+        }
+    }
+
+    // 写者: 取得可写缓冲区, 内容为此前某次发布的旧值, 可在其上原地修改后 publish()
+    T& beginWrite() {
+        if (writing_ == kNone) {
+            writing_ = acquireFreeBuffer();
+        }
+        return buffers_[writing_].value;
+    }
+
+    // 写者: 发布 beginWrite() 返回的缓冲区
+    void publish() {
+        if (writing_ == kNone) {
+            return;
+        }
+        latest_.store(writing_, std::memory_order_seq_cst);
+        writing_ = kNone;
+    }
+
+    // 写者: 复制 value 到可写缓冲区并发布, 复用缓冲区已有容量
+    void update(const T& value) {
+        beginWrite() = value;
+        publish();
+    }
+
+private:
+    static constexpr size_t kNone = static_cast<size_t>(-1);
+
+    size_t acquireFreeBuffer() {
+        while (true) {
+            size_t latest = latest_.load(std::memory_order_relaxed); // 只有写者修改
+            for (size_t i = 1; i < kBuffers; ++i) {
+                size_t index = (latest + i) % kBuffers;
+                if (buffers_[index].pins.load(std::memory_order_seq_cst) == 0) {
+                    return index;
+                }
+            }
+            cpuRelax();
+        }
+    }
+
+    Buffer buffers_[kBuffers];
+    std::atomic<size_t> latest_{0};
+    size_t writing_ = kNone; // 写者当前占用的缓冲区, 仅写者访问
+};
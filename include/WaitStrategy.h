@@ -0,0 +1,161 @@
+// WaitStrategy.h
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include "concurrentqueue/blockingconcurrentqueue.h" // moodycamel::LightweightSemaphore
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+// 消费者等待方式
+enum class WaitMode {
+    BLOCK,           // 直接在信号量上挂起, 不占 CPU
+    SPIN_THEN_PARK,  // 先自旋一段时间, 仍无数据再挂起
+    BUSY_POLL        // 始终自旋, 独占一个核心, 延迟最低
+};
+
+inline const char* waitModeName(WaitMode mode) {
+    switch (mode) {
+        case WaitMode::SPIN_THEN_PARK: return "spin";
+        case WaitMode::BUSY_POLL:      return "busy_poll";
+        default:                       return "block";
+    }
+}
+
+// 配置字符串 --> WaitMode, 无法识别时返回 default_mode
+inline WaitMode parseWaitMode(const std::string& name, WaitMode default_mode = WaitMode::BLOCK) {
+    if (name == "block") return WaitMode::BLOCK;
+    if (name == "spin") return WaitMode::SPIN_THEN_PARK;
+    if (name == "busy_poll") return WaitMode::BUSY_POLL;
+    return default_mode;
+}
+
+inline void cpuRelax() {
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#else
+    std::this_thread::yield();
+#endif
+}
+
+// 单消费者等待/唤醒
+// 消费者用 waitUntil(ready) 等待条件成立, 生产者发布数据后调用 notify();
+// 只有消费者真正挂起时 notify() 才会触碰信号量, 其余情况只是一次内存屏障加一次读
+// 一个 WaitStrategy 可以同时服务多个数据源, ready 中检查所有数据源即可
+class WaitStrategy {
+public:
+    explicit WaitStrategy(WaitMode mode = WaitMode::BLOCK, int spin_count = 4096)
+        : mode_(mode), spin_count_(spin_count) {}
+
+    WaitStrategy(const WaitStrategy&) = delete;
+    WaitStrategy& operator=(const WaitStrategy&) = delete;
+
+    // 须在消费者开始等待前设置
+    void setMode(WaitMode mode) { mode_ = mode; }
+    WaitMode mode() const { return mode_; }
+    void setSpinCount(int spin_count) { spin_count_ = spin_count; }
+    int spinCount() const { return spin_count_; }
+
+    // 消费者: 阻塞直到 ready() 返回 true
+    template<typename Ready>
+    void waitUntil(Ready&& ready) {
+        if (ready()) {
+            return;
+        }
+
+        if (mode_ == WaitMode::BUSY_POLL) {
+            while (!ready()) {
+                cpuRelax();
+            }
+            return;
+        }
+
+        if (mode_ == WaitMode::SPIN_THEN_PARK) {
+            for (int i = 0; i < spin_count_; ++i) {
+                if (ready()) {
+                    return;
+                }
+                cpuRelax();
+            }
+        }
+
+        // 先声明即将挂起再复查条件, 与 notify() 中先发布数据再检查 parked_ 配对, 不会丢失唤醒
+        while (true) {
+            parked_.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (ready()) {
+                parked_.store(false, std::memory_order_relaxed);
+                return;
+            }
+            sema_.wait();
+            if (ready()) {
+                return;
+            }
+        }
+    }
+
+    // 消费者: 阻塞直到 ready() 返回 true 或超过 timeout, 返回 ready() 是否成立
+    // 超时返回时可能残留一次信号, 只会让下一次等待多检查一轮条件
+    template<typename Ready>
+    bool waitUntilFor(Ready&& ready, std::chrono::microseconds timeout) {
+        if (ready()) {
+            return true;
+        }
+
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        if (mode_ == WaitMode::BUSY_POLL) {
+            while (!ready()) {
+                if (std::chrono::steady_clock::now() >= deadline) {
+                    return false;
+                }
+                cpuRelax();
+            }
+            return true;
+        }
+
+        if (mode_ == WaitMode::SPIN_THEN_PARK) {
+            for (int i = 0; i < spin_count_; ++i) {
+                if (ready()) {
+                    return true;
+                }
+                cpuRelax();
+            }
+        }
+
+        while (true) {
+            parked_.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (ready()) {
+                parked_.store(false, std::memory_order_relaxed);
+                return true;
+            }
+
+            auto remaining = std::chrono::duration_cast<std::chrono::microseconds>(deadline - std::chrono::steady_clock::now());
+            if (remaining.count() <= 0 || !sema_.wait(remaining.count())) {
+                parked_.store(false, std::memory_order_relaxed);
+                return ready();
+            }
+            if (ready()) {
+                return true;
+            }
+        }
+    }
+
+    // 生产者: 数据发布后调用
+    void notify() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (parked_.load(std::memory_order_relaxed) && parked_.exchange(false, std::memory_order_relaxed)) {
+            sema_.signal();
+        }
+    }
+
+private:
+    WaitMode mode_;
+    int spin_count_;
+    std::atomic<bool> parked_{false};
+    moodycamel::LightweightSemaphore sema_;
+};
@@ -1,20 +1,48 @@
 #include <iostream>
 
+#include "ConfigReader.h"
 #include "Logger.h"
 #include "ExecutorManager.h"
+#include "TickJournal.h"
+#include "ThreadAffinity.h"
 
 
 
-int main() {
+int main(int argc, char* argv[]) {
     static const char* module_name = "Main";
 
     // 初始化设置
     SetConsoleOutputCP(CP_UTF8); // 设置控制台为UTF-8编码以支持中文输出，防止exe运行时命令行输出乱码
 
+    // 日志后台线程的核心绑定须在创建线程池时设置, 先于 Executor 读取 [threads] 段
+    // 此时日志系统尚未初始化, 读取失败与无效的核心项先记下, 日志系统启动后再输出
+    std::vector<int> log_cores;
+    std::vector<std::string> rejected_log_cores;
+    std::string log_cores_error;
+    try {
+        log_cores = parseCoreList(ConfigReader("config.ini").get("threads", "log_cores"), &rejected_log_cores);
+    } catch (const std::exception& e) {
+        log_cores_error = e.what();
+    } catch (...) {
+        log_cores_error = "未知错误";
+    }
+
     // 初始化日志系统
-    init_log_system("logs/app.log");
+    init_log_system("logs/app.log", log_cores);
+
+    if (!log_cores_error.empty()) {
+        LOG_WARN(module_name, "读取 [threads] log_cores 失败, 日志线程不绑定核心: {}", log_cores_error);
+    }
+    for (const std::string& item : rejected_log_cores) {
+        LOG_WARN(module_name, "[threads] log_cores 中的 {} 无效, 已忽略", item);
+    }
 
     try {
+        // 逐笔日志转文本: main --journal-to-text <会话目录> [输出目录]
+        if (argc >= 3 && std::string(argv[1]) == "--journal-to-text") {
+            convertTickJournalToText(argv[2], argc >= 4 ? argv[3] : "data");
+            return 0;
+        }
 
         ExecutorManager manager;
         manager.run();
@@ -211,7 +239,7 @@ int main() {
         // auto event_list = parseL2Data(test_data, "order", test_buffer);
 
         // for (const auto& event : event_list) {
-        //     std::get<L2Order>(event.data).info();
+        //     event.order.info();
         // }
 
 
@@ -1,52 +1,209 @@
 #include "DataRouter.h"
 #include "L2Parser.h"
 #include "Logger.h"
+#include "L2Scanner.h"
+
+#include <algorithm>
 
 
 
 DataRouter::DataRouter(
-    std::unordered_map<std::string, std::unique_ptr<OrderBook>>& orderBooks_ref,
-    AsyncFileWriter& asyncFileWriter_ref
-): 
+    OrderBookRegistry& orderBooks_ref,
+    TickJournal* tickJournal_ptr,
+    const PipelineConfig& pipeline_config,
+    const ThreadRole& role
+):
+    route_batch_size_(pipeline_config.route_batch_size > 0 ? static_cast<size_t>(pipeline_config.route_batch_size) : 1),
+    role_(role),
     orderBooks_ref_(orderBooks_ref),
-    asyncFileWriter_ref_(asyncFileWriter_ref)
+    tickJournal_ptr_(tickJournal_ptr)
 {
+    LOG_INFO("DataRouter", "分隔符扫描指令集: {}", l2scan::isaLevelName(l2scan::activeIsaLevel()));
+
+    const DataMessage::MessageType types[kL2StreamCount] = {
+        DataMessage::MessageType::ORDER,
+        DataMessage::MessageType::TRADE
+    };
+
     running_ = true;
-    worker_thread_ = std::thread(&DataRouter::worker, this);
+    for (size_t i = 0; i < kL2StreamCount; ++i) {
+        Stream& stream = streams_[i];
+        stream.index = i;
+        stream.type = types[i];
+        stream.waiter.setMode(role_.wait_mode);
+        stream.waiter.setSpinCount(role_.spin_count);
+
+        if (pipeline_config.queue_type == QueueType::SPSC) {
+            stream.ring = std::make_unique<SpscRingBuffer<DataMessage>>(pipeline_config.ring_capacity);
+            stream.inbox.resize(64);
+        }
+
+        stream.thread = std::thread(&DataRouter::worker, this, std::ref(stream));
+    }
 }
 
 DataRouter::~DataRouter() {
     stop();
 }
 
-void DataRouter::pushData(const DataMessage& data_message) {
-    eventQueue_.enqueue(data_message);
+void DataRouter::pushData(DataMessage data_message) {
+    if (data_message.type_ != DataMessage::MessageType::ORDER &&
+        data_message.type_ != DataMessage::MessageType::TRADE) {
+        return;
+    }
+
+    Stream& stream = streams_[streamIndex(data_message.type_)];
+    if (!stream.ring) {
+        stream.queue.enqueue(std::move(data_message));
+        return;
+    }
+
+    // 每路行情只有一个接收线程, 满足单生产者; 队列满时反压接收线程
+    while (!stream.ring->try_push(std::move(data_message))) {
+        if (!running_) {
+            return;
+        }
+        stream.waiter.notify();
+        std::this_thread::yield();
+    }
+    stream.waiter.notify();
 }
 
-void DataRouter::worker() {
+void DataRouter::worker(Stream& stream) {
+    role_.pinThread(stream.index);
+
     while (running_) {
-        DataMessage data_message;
-        eventQueue_.wait_dequeue(data_message);
-
-        std::vector<MarketEvent> events;
-        if (data_message.type_ == DataMessage::MessageType::ORDER) {
-            events = parseL2Data(data_message.data_, data_message.type_, order_buffer_, asyncFileWriter_ref_);
-        } else if (data_message.type_ == DataMessage::MessageType::TRADE) {
-            events = parseL2Data(data_message.data_, data_message.type_, trade_buffer_, asyncFileWriter_ref_);
-        }
-
-        for (const auto &event : events) {
-            const std::string &symbol = getSymbol(event);
-            auto it = orderBooks_ref_.find(symbol);
-            if (it != orderBooks_ref_.end()) {
-                it->second->pushEvent(event);
-            } else {
-                LOG_WARN("DataRouter", "未找到对应的 OrderBook 处理数据，合约代码: {}", symbol);
+        // 有暂存事件时限时等待, 行情间歇期也按 kSpillRetryInterval 补投, 不依赖本路下一条消息到达
+        if (!stream.ring) {
+            DataMessage data_message;
+            bool received = waitMessage(stream, data_message);
+            retrySpilledBooks(stream);
+            if (received) {
+                handleMessage(stream, data_message);
             }
+            continue;
+        }
+
+        auto has_message = [&] {
+            return !stream.ring->empty() || !running_;
+        };
+        if (stream.spilled_symbols.empty()) {
+            stream.waiter.waitUntil(has_message);
+        } else {
+            stream.waiter.waitUntilFor(has_message, kSpillRetryInterval);
+        }
+        retrySpilledBooks(stream);
+
+        size_t count = stream.ring->try_pop_bulk(stream.inbox.data(), stream.inbox.size());
+        for (size_t i = 0; i < count; ++i) {
+            handleMessage(stream, stream.inbox[i]);
         }
     }
 }
 
+// moodycamel 队列按等待方式取一条消息: 先自旋轮询, 自旋用尽(busy_poll 为停止时)才挂起在队列上
+// 有暂存事件时最多等待 kSpillRetryInterval, 超时返回 false
+bool DataRouter::waitMessage(Stream& stream, DataMessage& data_message) {
+    const bool timed = !stream.spilled_symbols.empty();
+    const auto deadline = std::chrono::steady_clock::now() + kSpillRetryInterval;
+
+    const WaitMode mode = stream.waiter.mode();
+    if (mode != WaitMode::BLOCK) {
+        const int spin_count = stream.waiter.spinCount();
+        for (int i = 0; running_ && (mode == WaitMode::BUSY_POLL || i < spin_count); ++i) {
+            if (stream.queue.try_dequeue(data_message)) {
+                return true;
+            }
+            if (timed && mode == WaitMode::BUSY_POLL && std::chrono::steady_clock::now() >= deadline) {
+                return false;
+            }
+            cpuRelax();
+        }
+        if (!running_) {
+            return false;
+        }
+    }
+
+    if (timed) {
+        return stream.queue.wait_dequeue_timed(data_message, kSpillRetryInterval);
+    }
+    stream.queue.wait_dequeue(data_message);
+    return true;
+}
+
+void DataRouter::handleMessage(Stream& stream, const DataMessage& data_message) {
+    stream.events.clear();
+    parseL2Data(data_message.data_, stream.type, data_message.recv_time_us_, stream.decoder,
+        tickJournal_ptr_ ? &stream.journal_batch : nullptr, stream.events);
+    if (tickJournal_ptr_) {
+        tickJournal_ptr_->submit(stream.journal_batch);
+    }
+
+    // 按目标 OrderBook 分组, 每组一次 enqueue_bulk, 组内保持到达顺序
+    for (const auto &event : stream.events) {
+        SymbolId symbol_id = getSymbolId(event);
+        OrderBookBase* book = findOrderBook(stream, symbol_id);
+        if (!book) {
+            LOG_WARN("DataRouter", "未找到对应的 OrderBook 处理数据，合约代码: {}", SymbolTable::instance().name(symbol_id));
+            continue;
+        }
+
+        std::vector<MarketEvent>& batch = stream.route_batches[symbol_id];
+        if (batch.empty()) {
+            stream.touched_symbols.push_back(symbol_id);
+        }
+        batch.push_back(event);
+
+        if (batch.size() >= route_batch_size_) {
+            deliver(stream, symbol_id, book, batch.data(), batch.size());
+            batch.clear();
+        }
+    }
+
+    flushBatches(stream);
+}
+
+void DataRouter::deliver(Stream& stream, SymbolId symbol_id, OrderBookBase* book, const MarketEvent* events, size_t count) {
+    if (!book->pushEvents(stream.index, events, count) &&
+        std::find(stream.spilled_symbols.begin(), stream.spilled_symbols.end(), symbol_id) == stream.spilled_symbols.end()) {
+        stream.spilled_symbols.push_back(symbol_id);
+    }
+}
+
+void DataRouter::flushBatches(Stream& stream) {
+    for (SymbolId symbol_id : stream.touched_symbols) {
+        std::vector<MarketEvent>& batch = stream.route_batches[symbol_id];
+        if (!batch.empty()) {
+            // 合约在本分片内已查到过, OrderBook 只增不删
+            deliver(stream, symbol_id, orderBooks_ref_.find(symbol_id), batch.data(), batch.size());
+            batch.clear();
+        }
+    }
+    stream.touched_symbols.clear();
+}
+
+// 环形缓冲区先前已满的 OrderBook, 补投暂存事件; 由解析线程在处理新消息前与等待超时后调用
+void DataRouter::retrySpilledBooks(Stream& stream) {
+    if (stream.spilled_symbols.empty()) {
+        return;
+    }
+
+    stream.spilled_symbols.erase(
+        std::remove_if(stream.spilled_symbols.begin(), stream.spilled_symbols.end(), [&](SymbolId symbol_id) {
+            return orderBooks_ref_.find(symbol_id)->pushEvents(stream.index, nullptr, 0);
+        }),
+        stream.spilled_symbols.end());
+}
+
+// 注册表按 SymbolId 直接下标, 无锁查找; 同时保证 route_batches 覆盖该编号
+OrderBookBase* DataRouter::findOrderBook(Stream& stream, SymbolId symbol_id) {
+    OrderBookBase* book = orderBooks_ref_.find(symbol_id);
+    if (book && symbol_id >= stream.route_batches.size()) {
+        stream.route_batches.resize(SymbolTable::instance().size());
+    }
+    return book;
+}
+
 void DataRouter::stop() {
     if (!running_.exchange(false)) {
         return;
@@ -55,9 +212,17 @@ void DataRouter::stop() {
     LOG_INFO("DataRouter", "停止 DataRouter");
 
     // 发空包，唤醒阻塞的线程
-    eventQueue_.enqueue(DataMessage{});
-    
-    if (worker_thread_.joinable()) {
-        worker_thread_.join();
+    for (Stream& stream : streams_) {
+        if (stream.ring) {
+            stream.waiter.notify();
+        } else {
+            stream.queue.enqueue(DataMessage{});
+        }
     }
-}
\ No newline at end of file
+
+    for (Stream& stream : streams_) {
+        if (stream.thread.joinable()) {
+            stream.thread.join();
+        }
+    }
+}
@@ -35,12 +35,15 @@ void Executor::stop() {
     
     if (recvServer_) recvServer_->stop();
     if (dataRouter_) dataRouter_->stop();
+    if (workerPool_) workerPool_->stop();
     
-    if (asyncFileWriter_) asyncFileWriter_->stop();
+    if (tickJournal_) tickJournal_->stop();
     if (sendServer_) sendServer_->stop();
 
-    for (auto &orderBook : *orderBooks_) {
-        orderBook.second->stop();
+    if (orderBooks_) {
+        orderBooks_->forEach([](OrderBookBase& orderBook) {
+            orderBook.stop();
+        });
     }
 
     if (monitorEventThread_.joinable()) {
@@ -60,12 +63,30 @@ void Executor::init() {
     username_ = config.get("auth", "username");
     password_ = config.get("auth", "password");
     vol_flag_ = config.getInt("server", "vol_flag");
+    pipeline_config_ = loadPipelineConfig(config);
+    LOG_INFO(module_name_, "数据管道: 队列类型 {}, 等待策略 {}, 批量投递 {}, 单次处理上限 {}",
+        queueTypeName(pipeline_config_.queue_type), waitModeName(pipeline_config_.wait_mode),
+        pipeline_config_.route_batch_size, pipeline_config_.drain_limit);
+    price_band_config_ = loadPriceBandConfig(config);
+    LOG_INFO(module_name_, "价格档位: tick {}, 默认涨跌幅 {}%, 已配置涨跌停价的合约 {} 个",
+        price_band_config_.tick, price_band_config_.default_pct, price_band_config_.bands.size());
+    thread_config_ = loadThreadConfig(config, pipeline_config_.wait_mode);
+    LOG_INFO(module_name_, "线程绑定核心: 接收 {}, 解析 {} ({}), 处理 {} ({}), 逐笔日志 {}, 管道 {}",
+        coreListName(thread_config_.recv.cores),
+        coreListName(thread_config_.router.cores), waitModeName(thread_config_.router.wait_mode),
+        coreListName(thread_config_.book.cores), waitModeName(thread_config_.book.wait_mode),
+        coreListName(thread_config_.journal.cores), coreListName(thread_config_.send.cores));
     
-    asyncFileWriter_ = std::make_unique<AsyncFileWriter>();
+    // 逐笔原始数据日志
+    if (config.getInt("journal", "enabled", 1) != 0) {
+        tickJournal_ = std::make_unique<TickJournal>(
+            config.get("journal", "dir", "data/journal"),
+            static_cast<size_t>(config.getInt("journal", "segment_mb", 256)) << 20,
+            thread_config_.journal
+        );
+    }
 
-    orderBooks_ = std::make_unique<
-        std::unordered_map<std::string, std::unique_ptr<OrderBook>>
-    >();
+    orderBooks_ = std::make_unique<OrderBookRegistry>();
 
     cancelMonitorInfo_ = std::make_unique<
         AutoSaveJsonMap<std::string, std::vector<int>>
@@ -83,17 +104,25 @@ void Executor::init() {
         moodycamel::BlockingConcurrentQueue<std::string>
     >();
 
+    // 初始化 OrderBook 处理线程
+    workerPool_ = std::make_unique<ShardWorkerPool>(
+        static_cast<size_t>(thread_config_.book_workers),
+        thread_config_.book
+    );
+
     // 初始化数据路由器
     dataRouter_ = std::make_unique<DataRouter>(
         *orderBooks_,
-        *asyncFileWriter_
+        tickJournal_.get(),
+        pipeline_config_,
+        thread_config_.router
     );
 
     // 初始化交易信号发送服务器
-    sendServer_ = std::make_unique<SendServer>("to_python_pipe");
+    sendServer_ = std::make_unique<SendServer>("to_python_pipe", thread_config_.send);
 
     // 初始化队列信息发送服务器
-    queueSendServer_ = std::make_unique<SendServer>("cpp_to_nodejs_pipe");
+    queueSendServer_ = std::make_unique<SendServer>("cpp_to_nodejs_pipe", thread_config_.send);
 
     // 初始化HTTP下载器
     downloader_ = std::make_unique<L2HttpDownloader>(
@@ -110,7 +139,8 @@ void Executor::init() {
         username_, 
         password_, 
         DataMessage::MessageType::ORDER,
-        *dataRouter_
+        *dataRouter_,
+        thread_config_.recv
     );
     tradeSubscriber_ = std::make_unique<L2TcpSubscriber>(
         tcp_host_, 
@@ -118,7 +148,8 @@ void Executor::init() {
         username_, 
         password_, 
         DataMessage::MessageType::TRADE,
-        *dataRouter_
+        *dataRouter_,
+        thread_config_.recv
     );
 
     // 初始化接收前端消息服务器
@@ -220,16 +251,18 @@ void Executor::handleMonitorEvent(const std::string& symbol) {
         return;
     }
 
-    if (orderBooks_->find(symbol) != orderBooks_->end()) {
+    if (orderBooks_->find(symbol)) {
         LOG_INFO(module_name_, "股票代码 {} 的 OrderBook 已存在，跳过创建新实例", symbol);
         return;
     }
 
-    orderBooks_->emplace(
+    OrderBookBase* book = orderBooks_->add(
         symbol, 
-        std::make_unique<OrderBook>(
+        makeOrderBook(
             symbol, 
             vol_flag_,
+            pipeline_config_,
+            price_band_config_,
             *sendServer_,
             *queueSendServer_,
             *cancelMonitorInfo_,
@@ -237,6 +270,11 @@ void Executor::handleMonitorEvent(const std::string& symbol) {
             *queueMonitorInfo_
         )
     );
+    if (!book) {
+        LOG_ERROR(module_name_, "股票代码 {} 无法加入 OrderBook 注册表", symbol);
+        return;
+    }
+    workerPool_->attach(book, SymbolTable::instance().find(symbol));
 
     // 订阅逐笔委托和逐笔成交
     orderSubscriber_->subscribe(symbol); 
@@ -5,6 +5,8 @@
 #include "Logger.h"
 #include "FileOperator.h"
 #include "Base64Decoder.h"
+#include "L2Scanner.h"
+#include "L2Schema.h"
 #include <algorithm>
 #include <vector>
 
@@ -16,7 +18,7 @@ L2HttpDownloader::L2HttpDownloader(
     const std::string& base_url,
     const std::string& username,
     const std::string& password,
-    std::unordered_map<std::string, std::unique_ptr<OrderBook>>& orderBooks_ref
+    OrderBookRegistry& orderBooks_ref
 ) : base_url_(base_url),
     username_(username),
     password_(password),
@@ -161,13 +163,8 @@ std::string L2HttpDownloader::download(const std::string& symbol, const std::str
 }
 
 void L2HttpDownloader::parse_data(const std::string& symbol, const std::string& type, const std::string_view result_view) {
-    // 解析数据
-    size_t pos = 0;
-    constexpr size_t ORDER_FIELDS = 14;
-    constexpr size_t TRADE_FIELDS = 15;
-
-    auto it = orderBooks_ref_.find(symbol);
-    if (it == orderBooks_ref_.end()) {
+    OrderBookBase* book = orderBooks_ref_.find(symbol);
+    if (!book) {
         LOG_WARN("L2HttpDownloader", "未找到对应的 OrderBook 处理数据，合约代码: {}", symbol);
         return;
     }
@@ -176,92 +173,50 @@ void L2HttpDownloader::parse_data(const std::string& symbol, const std::string&
 
     std::vector<MarketEvent> market_events;
 
-    while (pos < result_view.size()) {
-        size_t next = result_view.find('\n', pos);
-
-        if (pos == 0) {
+    bool is_header = true;
+    l2scan::forEachCsvRecord(result_view, [&](const l2scan::L2RecordView& record) {
+        if (is_header) {
             // 跳过首行表头
-            pos = next + 1;
-            continue;
-        }
-
-        std::string_view line;
-        if (next == std::string_view::npos) {
-            line = result_view.substr(pos);
-        } else {
-            line = result_view.substr(pos, next - pos);
+            is_header = false;
+            return;
         }
 
-        auto fields = splitByComma(line);
-
         if (type == "Order") {
-            if  (fields.size() == ORDER_FIELDS) {
-                std::vector<std::string_view> relevant_fields = {
-                    fields[0], fields[1], fields[2], fields[3], fields[4], fields[5],
-                    fields[6], fields[7], fields[8], fields[9], fields[10], fields[11], fields[12]
-                };
-                
-                MarketEvent event = MarketEvent(L2Order(relevant_fields));
-                market_events.push_back(event);
-
-                // const auto& order = std::get<L2Order>(event.data);
-                // it->second->pushHistoryEvent(event);
-
-                // if (order.timestamp < 42000000) {
-                //     it->second->pushHistoryEvent(event);
-                // }
-            } else {
-                LOG_WARN("L2HttpDownloader", "order字段数不匹配, data:{} --> size:{}", line, fields.size());
+            L2Order& order = market_events.emplace_back(L2Order{}).order;
+            if (!parseL2Record<L2Order, HttpLayout>(record, order)) {
+                market_events.pop_back();
+                LOG_WARN("L2HttpDownloader", "order字段数不匹配, data:{} --> size:{}", record.text, record.field_count);
             }
         } else if (type == "Tran") {
-            if (fields.size() == TRADE_FIELDS) {
-                std::vector<std::string_view> relevant_fields = {
-                    fields[0], fields[1], fields[2], fields[3], fields[4], fields[5],
-                    fields[6], fields[7], fields[8], fields[9], fields[10], 
-                    fields[11], fields[12], fields[13]
-                };
-
-                MarketEvent event = MarketEvent(L2Trade(relevant_fields));
-                market_events.push_back(event);
-
-                // const auto& trade = std::get<L2Trade>(event.data);
-                // it->second->pushHistoryEvent(event);
-
-                // if (trade.timestamp < 42000000) {
-                //     it->second->pushHistoryEvent(event);
-                // }
-            } else {
-                LOG_WARN("L2HttpDownloader", "trade字段数不匹配, data:{} --> size:{}", line, fields.size());
+            L2Trade& trade = market_events.emplace_back(L2Trade{}).trade;
+            if (!parseL2Record<L2Trade, HttpLayout>(record, trade)) {
+                market_events.pop_back();
+                LOG_WARN("L2HttpDownloader", "trade字段数不匹配, data:{} --> size:{}", record.text, record.field_count);
             }
         }
-        pos = next + 1;
-    }
+    });
 
     // 标记历史数据下载处理完成
     if (type == "Order") {
         // 按id字段排序
         std::sort(market_events.begin(), market_events.end(), [](const MarketEvent& a, const MarketEvent& b) {
-            return std::get<L2Order>(a.data).id < std::get<L2Order>(b.data).id;
+            return a.order.id < b.order.id;
         });
         
-        // 加入队列
-        for (auto& event : market_events) {
-            it->second->pushHistoryEvent(event);
-        }
+        // 整批加入队列
+        book->pushHistoryEvents(market_events.data(), market_events.size());
 
-        it->second->is_history_order_done_.store(true);
+        book->is_history_order_done_.store(true);
     } else if (type == "Tran") {
         // 按timestamp字段排序
         std::sort(market_events.begin(), market_events.end(), [](const MarketEvent& a, const MarketEvent& b) {
-            return std::get<L2Trade>(a.data).timestamp < std::get<L2Trade>(b.data).timestamp;
+            return a.trade.timestamp < b.trade.timestamp;
         });
         
-        // 加入队列
-        for (auto& event : market_events) {
-            it->second->pushHistoryEvent(event);
-        }
+        // 整批加入队列
+        book->pushHistoryEvents(market_events.data(), market_events.size());
         
-        it->second->is_history_trade_done_.store(true);
+        book->is_history_trade_done_.store(true);
     }
 }
 
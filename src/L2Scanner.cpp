@@ -0,0 +1,186 @@
+#include "L2Scanner.h"
+#include "Logger.h"
+
+#include <atomic>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define L2SCAN_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(L2SCAN_X86) && (defined(__GNUC__) || defined(__clang__))
+#define L2SCAN_TARGET(isa) __attribute__((target(isa)))
+#else
+#define L2SCAN_TARGET(isa)
+#endif
+
+namespace l2scan {
+
+namespace {
+
+using MaskKernel = void (*)(const char*, size_t, uint64_t*);
+
+struct DelimiterTable {
+    bool is_delimiter[256] = {};
+    DelimiterTable() {
+        is_delimiter[static_cast<unsigned char>(',')] = true;
+        is_delimiter[static_cast<unsigned char>('#')] = true;
+        is_delimiter[static_cast<unsigned char>('<')] = true;
+        is_delimiter[static_cast<unsigned char>('>')] = true;
+        is_delimiter[static_cast<unsigned char>('\n')] = true;
+    }
+};
+
+const DelimiterTable g_delimiter_table;
+
+void buildMasksScalar(const char* data, size_t block_count, uint64_t* masks) {
+    for (size_t b = 0; b < block_count; ++b) {
+        const unsigned char* block = reinterpret_cast<const unsigned char*>(data + b * kBlockBytes);
+        uint64_t mask = 0;
+        for (size_t i = 0; i < kBlockBytes; ++i) {
+            mask |= static_cast<uint64_t>(g_delimiter_table.is_delimiter[block[i]]) << i;
+        }
+        masks[b] = mask;
+    }
+}
+
+#ifdef L2SCAN_X86
+
+// SSE4.2: PCMPESTRM 一条指令完成 16 字节对分隔符集合的匹配
+L2SCAN_TARGET("sse4.2")
+void buildMasksSse42(const char* data, size_t block_count, uint64_t* masks) {
+    const __m128i delimiters = _mm_setr_epi8(',', '#', '<', '>', '\n', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    constexpr int kMode = _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_BIT_MASK;
+
+    for (size_t b = 0; b < block_count; ++b) {
+        const char* block = data + b * kBlockBytes;
+        uint64_t mask = 0;
+        for (int lane = 0; lane < 4; ++lane) {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + lane * 16));
+            __m128i hits = _mm_cmpestrm(delimiters, 5, chunk, 16, kMode);
+            mask |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_cvtsi128_si32(hits))) << (lane * 16);
+        }
+        masks[b] = mask;
+    }
+}
+
+// AVX2: 每 32 字节与 5 个分隔符逐一比较后合并
+L2SCAN_TARGET("avx2")
+inline uint64_t matchAvx2(const char* p) {
+    const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    __m256i hits = _mm256_or_si256(
+        _mm256_or_si256(
+            _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(',')),
+            _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('#'))),
+        _mm256_or_si256(
+            _mm256_or_si256(
+                _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('<')),
+                _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('>'))),
+            _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\n'))));
+    return static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(hits)));
+}
+
+L2SCAN_TARGET("avx2")
+void buildMasksAvx2(const char* data, size_t block_count, uint64_t* masks) {
+    for (size_t b = 0; b < block_count; ++b) {
+        const char* block = data + b * kBlockBytes;
+        masks[b] = matchAvx2(block) | (matchAvx2(block + 32) << 32);
+    }
+}
+
+IsaLevel queryCpu() {
+#if defined(_MSC_VER)
+    int info[4] = {0};
+    __cpuid(info, 0);
+    const int max_leaf = info[0];
+
+    __cpuid(info, 1);
+    const bool sse42 = (info[2] & (1 << 20)) != 0;
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+
+    bool avx2 = false;
+    if (max_leaf >= 7 && osxsave && avx && (_xgetbv(0) & 0x6) == 0x6) {
+        __cpuidex(info, 7, 0);
+        avx2 = (info[1] & (1 << 5)) != 0;
+    }
+#else
+    __builtin_cpu_init();
+    const bool sse42 = __builtin_cpu_supports("sse4.2");
+    const bool avx2 = __builtin_cpu_supports("avx2");
+#endif
+
+    if (avx2) return IsaLevel::AVX2;
+    if (sse42) return IsaLevel::SSE42;
+    return IsaLevel::SCALAR;
+}
+
+#else
+
+IsaLevel queryCpu() {
+    return IsaLevel::SCALAR;
+}
+
+#endif
+
+MaskKernel kernelFor(IsaLevel level) {
+#ifdef L2SCAN_X86
+    switch (level) {
+        case IsaLevel::AVX2:  return &buildMasksAvx2;
+        case IsaLevel::SSE42: return &buildMasksSse42;
+        default: break;
+    }
+#endif
+    return &buildMasksScalar;
+}
+
+struct Dispatcher {
+    IsaLevel detected;
+    std::atomic<int> active;
+    std::atomic<MaskKernel> kernel;
+
+    Dispatcher() : detected(queryCpu()) {
+        active.store(static_cast<int>(detected));
+        kernel.store(kernelFor(detected));
+    }
+};
+
+Dispatcher& dispatcher() {
+    static Dispatcher instance;
+    return instance;
+}
+
+} // namespace
+
+IsaLevel detectIsaLevel() {
+    return dispatcher().detected;
+}
+
+IsaLevel activeIsaLevel() {
+    return static_cast<IsaLevel>(dispatcher().active.load(std::memory_order_relaxed));
+}
+
+bool setIsaLevel(IsaLevel level) {
+    Dispatcher& d = dispatcher();
+    if (static_cast<int>(level) > static_cast<int>(d.detected)) {
+        LOG_WARN("L2Scanner", "CPU 不支持 {} 指令集, 保持 {}", isaLevelName(level), isaLevelName(activeIsaLevel()));
+        return false;
+    }
+    d.kernel.store(kernelFor(level), std::memory_order_relaxed);
+    d.active.store(static_cast<int>(level), std::memory_order_relaxed);
+    return true;
+}
+
+const char* isaLevelName(IsaLevel level) {
+    switch (level) {
+        case IsaLevel::AVX2:  return "AVX2";
+        case IsaLevel::SSE42: return "SSE4.2";
+        default:              return "Scalar";
+    }
+}
+
+void buildDelimiterMasks(const char* data, size_t block_count, uint64_t* masks) {
+    dispatcher().kernel.load(std::memory_order_relaxed)(data, block_count, masks);
+}
+
+} // namespace l2scan
@@ -40,9 +40,9 @@ static WinSockInitializer g_winsockInit;
 L2TcpSubscriber::L2TcpSubscriber(
     const std::string &host, int port, const std::string &username,
     const std::string &password, DataMessage::MessageType type,
-    DataRouter &dataRouter_ref)
+    DataRouter &dataRouter_ref, const ThreadRole &recv_role)
     : host_(host), port_(port), username_(username), password_(password),
-      type_(type), dataRouter_ref_(dataRouter_ref), running_(true),
+      type_(type), dataRouter_ref_(dataRouter_ref), recv_role_(recv_role), running_(true),
       is_logined_(false), sock_(INVALID_SOCKET) {}
 
 L2TcpSubscriber::~L2TcpSubscriber() { stop(); }
@@ -249,6 +249,7 @@ bool L2TcpSubscriber::isContainStrFlag(const char *data, size_t len,
 
 void L2TcpSubscriber::receiveLoop() {
   LOG_INFO(module_name, "启动接收线程 <{}:{}>", host_, port_);
+  recv_role_.pinThread(streamIndex(type_));
 
   while (running_) { 
     std::string data = recvData();
@@ -263,7 +264,7 @@ void L2TcpSubscriber::receiveLoop() {
 
     // LOG_INFO(module_name, "接收行情数据: {}", data);
 
-    dataRouter_ref_.pushData(DataMessage(std::move(data), type_));
+    dataRouter_ref_.pushData(DataMessage(std::move(data), type_, TickJournal::nowMicros()));
   }
 }
 
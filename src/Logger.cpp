@@ -1,4 +1,5 @@
 #include "Logger.h"
+#include "ThreadAffinity.h"
 
 #include <spdlog/spdlog.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
@@ -24,13 +25,14 @@ static std::mutex g_loggers_mutex;  // 创建互斥锁，保护多线程安全
 static bool g_async_pool_initialized = false;
 
 // 初始化日志系统
-bool init_log_system(const char* filename) {
+bool init_log_system(const char* filename, const std::vector<int>& log_cores) {
     try {
         if (!g_async_pool_initialized) {
             // 队列大小，例如 8192；后台线程数量，例如 1
             // 队列大小需要根据你的日志吞吐量调整，如果日志量很大，可能需要更大。
             // 后台线程数一般 1 个就够了，除非你有多个 sink 且 I/O 非常重。
-            spdlog::init_thread_pool(8192, 1); 
+            // 后台线程启动时绑定核心, 此时日志系统尚未就绪, 绑定结果不写日志
+            spdlog::init_thread_pool(8192, 1, [log_cores] { pinCurrentThread(log_cores); });
             g_async_pool_initialized = true;
         }
 
@@ -5,13 +5,20 @@
 #include "SendServer.h"
 
 #include <algorithm>
+#include <chrono>
+#include <climits>
 #include <vector>
 
 static const char* module_name = "OrderBook";
 
-OrderBook::OrderBook(
+// 排单位置只统计此时间(9:15:01)之前的挂单
+static const int kQueueTimeCutoff = 33301000;
+
+OrderBookBase::OrderBookBase(
     const std::string symbol,
     const int vol_flag,
+    const PipelineConfig& pipeline_config,
+    const PriceBandConfig& price_band_config,
     SendServer& sendServer_ref,
     SendServer& queueSendServer_ref,
     AutoSaveJsonMap<std::string, std::vector<int>>& cancelMonitorInfo_ref,
@@ -20,6 +27,11 @@ OrderBook::OrderBook(
 ) : 
     symbol_(symbol), 
     vol_flag_(vol_flag),
+    bids_(price_band_config.tick, price_band_config.default_pct),
+    asks_(price_band_config.tick, price_band_config.default_pct),
+    pending_matches_(pipeline_config.pending_max_age_ms, static_cast<uint64_t>(std::max(pipeline_config.pending_max_events, 0))),
+    drain_limit_(pipeline_config.drain_limit > 0 ? static_cast<size_t>(pipeline_config.drain_limit) : 1),
+    drain_buffer_(drain_limit_),
     sendServer_ref_(sendServer_ref), 
     queueSendServer_ref_(queueSendServer_ref),
     cancelMonitorInfo_ref_(cancelMonitorInfo_ref), 
@@ -31,302 +43,388 @@ OrderBook::OrderBook(
         return;
     };
 
-    market_flag_ = symbol_[0] == '6' ? "SH" : "SZ";
+    // 已配置涨跌停价的合约按区间预分配价格档位, 未配置的在首笔挂单时推算
+    if (const PriceBand* band = price_band_config.find(symbol_)) {
+        bids_.reserve(band->limit_down, band->limit_up);
+        asks_.reserve(band->limit_down, band->limit_up);
+        LOG_INFO(module_name, "[{}] 价格档位区间: {:.4f} ~ {:.4f}", symbol_, band->limit_down / 10000.0, band->limit_up / 10000.0);
+    }
 
-    processing_thread_ = std::thread(&OrderBook::runProcessingLoop, this);
+    if (pipeline_config.queue_type == QueueType::SPSC) {
+        for (EventChannel& channel : event_channels_) {
+            channel.ring = std::make_unique<SpscRingBuffer<MarketEvent>>(pipeline_config.ring_capacity);
+        }
+    }
 }
 
-OrderBook::~OrderBook() {
+OrderBookBase::~OrderBookBase() {
     stop();
 }
 
-void OrderBook::pushHistoryEvent(const MarketEvent& event) {
+template<typename Policy>
+OrderBook<Policy>::OrderBook(
+    const std::string symbol,
+    const int vol_flag,
+    const PipelineConfig& pipeline_config,
+    const PriceBandConfig& price_band_config,
+    SendServer& sendServer_ref,
+    SendServer& queueSendServer_ref,
+    AutoSaveJsonMap<std::string, std::vector<int>>& cancelMonitorInfo_ref,
+    AutoSaveJsonMap<std::string, std::unordered_map<int, int>>& sellMonitorInfo_ref,
+    AutoSaveJsonMap<std::string, std::vector<int>>& queueMonitorInfo_ref
+) :
+    OrderBookBase(
+        symbol,
+        vol_flag,
+        pipeline_config,
+        price_band_config,
+        sendServer_ref,
+        queueSendServer_ref,
+        cancelMonitorInfo_ref,
+        sellMonitorInfo_ref,
+        queueMonitorInfo_ref
+    )
+{
+}
+
+void OrderBookBase::pushHistoryEvent(const MarketEvent& event) {
     history_event_queue.enqueue(event);
+    schedule();
+}
+
+void OrderBookBase::pushHistoryEvents(const MarketEvent* events, size_t count) {
+    history_event_queue.enqueue_bulk(events, count);
+    schedule();
+}
+
+void OrderBookBase::pushEvent(const MarketEvent& event) {
+    pushEvents(0, &event, 1);
+}
+
+// stream 为 streamIndex(), 同一路行情的事件按投递顺序处理
+// SPSC 模式下每个通道只允许 DataRouter 对应路的线程调用(stop 时路由线程已退出)
+// 环形缓冲区满时(如历史数据尚未加载完, 实时事件持续积压)不阻塞生产者, 剩余事件按序暂存在 spill,
+// 返回 false 表示仍有暂存事件, 需要生产者之后调用 pushEvents(stream, nullptr, 0) 继续投递
+bool OrderBookBase::pushEvents(size_t stream, const MarketEvent* events, size_t count) {
+    EventChannel& channel = event_channels_[stream];
+    if (!channel.ring) {
+        event_queue.enqueue_bulk(events, count);
+        schedule();
+        return true;
+    }
+
+    // 先投递更早的暂存事件, 保证顺序
+    if (channel.spill_head < channel.spill.size()) {
+        channel.spill_head += channel.ring->try_push_bulk(
+            channel.spill.data() + channel.spill_head, channel.spill.size() - channel.spill_head);
+        if (channel.spill_head == channel.spill.size()) {
+            channel.spill.clear();
+            channel.spill_head = 0;
+        }
+    }
+
+    if (channel.spill.empty() && count > 0) {
+        size_t pushed = channel.ring->try_push_bulk(events, count);
+        events += pushed;
+        count -= pushed;
+    }
+
+    if (count > 0) {
+        channel.spill.insert(channel.spill.end(), events, events + count);
+    }
+
+    schedule();
+    return channel.spill.empty();
 }
 
-void OrderBook::pushEvent(const MarketEvent& event) {
-    event_queue.enqueue(event);
+// 取出一批实时事件, 不阻塞, 无事件时返回 0
+size_t OrderBookBase::dequeueEvents() {
+    if (!event_channels_[0].ring) {
+        return event_queue.try_dequeue_bulk(drain_buffer_.data(), drain_limit_);
+    }
+
+    size_t count = 0;
+    for (size_t i = 0; i < kL2StreamCount && count < drain_limit_; ++i) {
+        EventChannel& channel = event_channels_[(next_channel_ + i) % kL2StreamCount];
+        count += channel.ring->try_pop_bulk(drain_buffer_.data() + count, drain_limit_ - count);
+    }
+    next_channel_ = (next_channel_ + 1) % kL2StreamCount;
+    return count;
 }
 
-void OrderBook::stop() {
+void OrderBookBase::stop() {
     // exchange 设置 running_ 为 false, 并返回之前的值
     if (!running_.exchange(false)) {
         return;
     }
 
     LOG_INFO(module_name, "停止 OrderBook");
+}
+
+void OrderBookBase::bindReadyQueue(BookReadyQueue* ready_queue) {
+    ready_queue_.store(ready_queue, std::memory_order_release);
+    schedule();
+}
 
-    event_queue.enqueue(MarketEvent{}); // 触发退出
+void OrderBookBase::schedule() {
+    BookReadyQueue* ready_queue = ready_queue_.load(std::memory_order_acquire);
+    if (ready_queue && !scheduled_.exchange(true, std::memory_order_acq_rel)) {
+        ready_queue->push(this);
+    }
+}
 
-    if (processing_thread_.joinable()) {
-        processing_thread_.join();
+void OrderBookBase::clearScheduled() {
+    scheduled_.exchange(false, std::memory_order_acq_rel);
+}
+
+void OrderBookBase::onTimer() {
+    if (!running_) {
+        return;
     }
 
-    if (print_thread_.joinable()) {
-        print_thread_.join();
+    if (isLive()) {
+        printOrderBook(5);
+    } else {
+        // 下载器设置完成标记时不会再投递事件, 由定时任务触发排序与回放
+        schedule();
     }
 }
 
+// 历史数据已回放完毕, 进入实时处理阶段
+bool OrderBookBase::isLive() const {
+    return is_history_event_buffer_done_.load();
+}
+
 // 检查历史数据加载是否完成
-bool OrderBook::isHistoryDataLoadingComplete() const {
+bool OrderBookBase::isHistoryDataLoadingComplete() const {
     return (is_history_order_done_.load() && is_history_trade_done_.load());
 }
 
-// 生成历史数据去重集合
-void OrderBook::generateDuplicateSets() {
-    // 生成历史数据去重集合
+// 处理线程调用: 历史数据阶段接收并回放历史事件, 之后处理实时事件
+template<typename Policy>
+bool OrderBook<Policy>::poll() {
+    if (!running_) {
+        return false;
+    }
 
-    for (auto it = history_order_timeId_.begin(); it != history_order_timeId_.end(); ++it) {
-        if (last_event_timestamp_ - it->second <= 600000) {
-            // 记录一分钟内的历史数据ID
-            history_order_id_.insert(it->first);
-        }
+    if (!isLive()) {
+        return pollHistory();
     }
+    return pollLive();
+}
 
-    // 清空vector释放内存
-    std::vector<std::pair<int, int>>().swap(history_order_timeId_);
+template<typename Policy>
+bool OrderBook<Policy>::pollHistory() {
+    if (!history_sorted_) {
+        // 先读完成标记再取队列: 标记成立后下载器不再投递, 此时取空即已全部接收
+        bool loading_complete = isHistoryDataLoadingComplete();
 
-    for (auto it = history_trade_timeId_.begin(); it != history_trade_timeId_.end(); ++it) {
-        if (last_event_timestamp_ - it->second <= 600000) {
-            // 记录一分钟内的历史数据ID
-            history_trade_id_.insert(it->first);
+        // 首次取数时按队列现有长度预留排序缓冲区, 之后按 drain_buffer_ 定长分批取出追加, 不做值初始化
+        if (history_event_buffer_.capacity() == 0) {
+            history_event_buffer_.reserve(std::max(history_event_queue.size_approx(), drain_limit_));
+        }
+        size_t count = history_event_queue.try_dequeue_bulk(drain_buffer_.data(), drain_limit_);
+        if (count > 0) {
+            history_event_buffer_.insert(history_event_buffer_.end(), drain_buffer_.begin(), drain_buffer_.begin() + count);
+            return true;
         }
+
+        if (!loading_complete) {
+            return false;
+        }
+
+        // 历史数据接受完毕，对订单进行事件排序, 排序是为了保证回溯时候指标的正确触发
+        std::stable_sort(history_event_buffer_.begin(), history_event_buffer_.end(), [](const MarketEvent& a, const MarketEvent& b) {
+            int timestamp_a = (a.type == MarketEvent::EventType::ORDER) ? a.order.timestamp : a.trade.timestamp;
+            int timestamp_b = (b.type == MarketEvent::EventType::ORDER) ? b.order.timestamp : b.trade.timestamp;
+            return timestamp_a < timestamp_b;
+        });
+        reserveHistoryLevels(history_event_buffer_.data(), history_event_buffer_.size());
+        history_sorted_ = true;
+        history_replay_pos_ = 0;
+        history_replay_seconds_ = 0.0;
+        LOG_INFO(module_name, "历史数据接收完毕，排序完毕");
+    }
+
+    // 开始进行撮合, 每次 poll() 只回放一块, 未回放完时让出处理线程, 同线程的其它订单簿不被阻塞
+    const size_t total = history_event_buffer_.size();
+    const size_t chunk = std::min(drain_limit_, total - history_replay_pos_);
+    replayHistory(history_event_buffer_.data() + history_replay_pos_, chunk);
+    history_replay_pos_ += chunk;
+    if (history_replay_pos_ < total) {
+        return true;
     }
 
-    // 清空vector释放内存
-    std::vector<std::pair<int, int>>().swap(history_trade_timeId_);
+    LOG_INFO(module_name, "[{}] 历史数据回放 {} 条, 耗时 {:.3f} 秒, {:.0f} 条/秒",
+        symbol_, total, history_replay_seconds_, history_replay_seconds_ > 0 ? total / history_replay_seconds_ : 0.0);
+    std::vector<MarketEvent>().swap(history_event_buffer_);
+    history_replay_pos_ = 0;
+
+    is_cancel_send_ = false;
+    is_sell_send_ = false;
+    is_history_event_buffer_done_.store(true);
+    publishSnapshot();
+    LOG_INFO(module_name, "[{}] 历史数据覆盖委托通道 {} 个, 成交通道 {} 个",
+        symbol_, history_order_watermark_.channels(), history_trade_watermark_.channels());
+    LOG_INFO(module_name, "历史事件处理完毕，开始处理实时事件队列...");
+
+    // 回放期间积压的实时事件
+    return true;
 }
 
-// 主线程循环
-void OrderBook::runProcessingLoop() {
-    while (running_) {
-        if (isHistoryDataLoadingComplete() == false
-            || is_history_event_queue_done_.load() == false  
-            || is_history_event_buffer_done_.load() == false
-        ) {
-            MarketEvent hist_evt;
-            if (!history_event_queue.wait_dequeue_timed(hist_evt, std::chrono::milliseconds(3000)) &&
-             is_history_event_queue_done_.load() == false) {
-                if (isHistoryDataLoadingComplete()) {
-                    // 历史数据接受完毕，对订单进行事件排序, 排序是为了保证回溯时候指标的正确触发
-                    std::stable_sort(history_event_buffer_.begin(), history_event_buffer_.end(), [](const MarketEvent& a, const MarketEvent& b) {
-                        int timestamp_a = (a.type == MarketEvent::EventType::ORDER) ? std::get<L2Order>(a.data).timestamp : std::get<L2Trade>(a.data).timestamp;
-                        int timestamp_b = (b.type == MarketEvent::EventType::ORDER) ? std::get<L2Order>(b.data).timestamp : std::get<L2Trade>(b.data).timestamp;
-                        return timestamp_a < timestamp_b;
-                    });
+// 回放前按历史委托价格区间一次性预分配价格档位, 回放中不再扩容
+template<typename Policy>
+void OrderBook<Policy>::reserveHistoryLevels(const MarketEvent* events, size_t count) {
+    int bid_low = INT_MAX, bid_high = 0;
+    int ask_low = INT_MAX, ask_high = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const MarketEvent& event = events[i];
+        if (event.type != MarketEvent::EventType::ORDER || event.order.type != 2 || event.order.price <= 0) {
+            continue;
+        }
+        if (event.order.side == 1) {
+            bid_low = std::min(bid_low, event.order.price);
+            bid_high = std::max(bid_high, event.order.price);
+        } else {
+            ask_low = std::min(ask_low, event.order.price);
+            ask_high = std::max(ask_high, event.order.price);
+        }
+    }
+    if (bid_high > 0) bids_.reserve(bid_low, bid_high);
+    if (ask_high > 0) asks_.reserve(ask_low, ask_high);
+}
 
-                    is_history_event_queue_done_.store(true);
-                    LOG_INFO(module_name, "历史数据接收完毕，排序完毕");
-                }
-                continue;
-            }
+// 历史事件批量回放, 由 pollHistory 按块调用
+// 只做订单簿撮合与通道序号记录, 不判断信号(checkLimitUpWithdrawal)、不发布快照
+template<typename Policy>
+void OrderBook<Policy>::replayHistory(const MarketEvent* events, size_t count) {
+    const auto start_time = std::chrono::steady_clock::now();
 
-            // 在历史事件队列处理完毕后才进入下一步
-            if (is_history_event_queue_done_.load() == false) {
-                history_event_buffer_.push_back(hist_evt);
-                continue;
-            }
-            
-            // 开始进行撮合
-            for (auto it = history_event_buffer_.begin(); it != history_event_buffer_.end(); ++it) {
-                std::lock_guard<std::mutex> lock(mtx_);
+    for (size_t i = 0; i < count; ++i) {
+        const MarketEvent& event = events[i];
+        if (event.type == MarketEvent::EventType::ORDER) {
+            handleOrderEvent(event);
 
-                if (!running_) break;
-                
-                int timestamp = 0;
-                if (it->type == MarketEvent::EventType::ORDER) {
-                    handleOrderEvent(*it);
+            // 记录各通道已回放的最大序号
+            history_order_watermark_.observe(event.order.channel, Policy::orderSequence(event.order));
+        } else if (event.type == MarketEvent::EventType::TRADE) {
+            handleTradeEvent(event);
 
-                    // 记录历史数据ID与时间戳映射
-                    history_order_timeId_.push_back(
-                        {std::get<L2Order>(it->data).num1, std::get<L2Order>(it->data).timestamp}
-                    );
+            // 记录各通道已回放的最大序号
+            history_trade_watermark_.observe(event.trade.channel, event.trade.num1);
+        }
+    }
 
-                    timestamp = std::get<L2Order>(it->data).timestamp;
-                } else if (it->type == MarketEvent::EventType::TRADE) {
-                    handleTradeEvent(*it);
+    history_replay_seconds_ += std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+}
 
-                    // 记录历史数据ID与时间戳映射
-                    history_trade_timeId_.push_back(
-                        {std::get<L2Trade>(it->data).num1, std::get<L2Trade>(it->data).timestamp}
-                    );
+template<typename Policy>
+bool OrderBook<Policy>::pollLive() {
+    // 处理实时事件队列, 一次批量取出
+    size_t count = dequeueEvents();
+    if (count == 0) {
+        return false;
+    }
 
-                    timestamp = std::get<L2Trade>(it->data).timestamp;
-                }
+    for (size_t i = 0; i < count; ++i) {
+        const MarketEvent& evt = drain_buffer_[i];
 
-                // checkLimitUpWithdrawal(timestamp);   
-                
-            }
-            std::vector<MarketEvent>().swap(history_event_buffer_);
-
-            is_cancel_send_ = false;
-            is_sell_send_ = false;
-            is_history_event_buffer_done_.store(true);
-            generateDuplicateSets();
-
-            // printOrderBook(10);
-            // int timestamp = 41400000;
-            // checkLimitUpWithdrawal(timestamp);   
-            LOG_INFO(module_name, "历史事件处理完毕，开始处理实时事件队列...");
-            
-        } else {
-            // 启动打印线程
-            if (!print_thread_.joinable()) {
-                print_thread_ = std::thread(&OrderBook::printloop, this, 5);
+        // 处理重复事件: 通道序号不超过历史数据的最大序号, 说明已由历史数据处理过
+        if (evt.type == MarketEvent::EventType::ORDER) {
+            if (history_order_watermark_.covers(evt.order.channel, Policy::orderSequence(evt.order))) {
+                LOG_INFO(module_name, "出现重复单, 订单编号:{}", evt.order.num1);
+                continue;
             }
-
-            // 处理实时事件队列
-            MarketEvent evt;
-            event_queue.wait_dequeue(evt);
-
-            // 处理重复事件
-            if (evt.type == MarketEvent::EventType::ORDER) {
-                if (history_order_id_.find(std::get<L2Order>(evt.data).num1) != history_order_id_.end()) {
-                    LOG_INFO(module_name, "出现重复单, 订单编号:{}", std::get<L2Order>(evt.data).num1);
-                    continue;
-                }
-            } else if (evt.type == MarketEvent::EventType::TRADE) {
-                if (history_trade_id_.find(std::get<L2Trade>(evt.data).num1) != history_trade_id_.end()) {
-                    LOG_INFO(module_name, "出现重复单, 成交编号:{}", std::get<L2Trade>(evt.data).num1);
-                    continue;
-                }
+        } else if (evt.type == MarketEvent::EventType::TRADE) {
+            if (history_trade_watermark_.covers(evt.trade.channel, evt.trade.num1)) {
+                LOG_INFO(module_name, "出现重复单, 成交编号:{}", evt.trade.num1);
+                continue;
             }
+        }
 
-            std::lock_guard<std::mutex> lock(mtx_);
+        int timestamp = 0;
+        if (evt.type == MarketEvent::EventType::ORDER) {
+            handleOrderEvent(evt);
+            timestamp = evt.order.timestamp;
+        } else if (evt.type == MarketEvent::EventType::TRADE) {
+            handleTradeEvent(evt);
+            timestamp = evt.trade.timestamp;
+        }
 
-            if (!running_) break;
+        // 检查涨停撤单
+        checkLimitUpWithdrawal(timestamp);
 
-            int timestamp = 0;
-            if (evt.type == MarketEvent::EventType::ORDER) {
-                handleOrderEvent(evt);
-                timestamp = std::get<L2Order>(evt.data).timestamp;
-            } else if (evt.type == MarketEvent::EventType::TRADE) {
-                handleTradeEvent(evt);
-                timestamp = std::get<L2Trade>(evt.data).timestamp;
-            }
+        loop_count_ += 1;
+    }
 
-            // 检查涨停撤单
-            checkLimitUpWithdrawal(timestamp);
+    publishSnapshot();
 
-            loop_count_ += 1;
-        }
-    }
+    // 取满一批说明可能仍有积压, 让出处理线程后再次调度
+    return count == drain_limit_;
 }
 
 // 处理逐笔委托
-void OrderBook::handleOrderEvent(const MarketEvent& event){
+template<typename Policy>
+void OrderBook<Policy>::handleOrderEvent(const MarketEvent& event){
 
-    const auto& order = std::get<L2Order>(event.data);
+    const auto& order = event.order;
 
     if (order.timestamp > last_event_timestamp_) {
         last_event_timestamp_ = order.timestamp;
     }
-    
-    if (market_flag_ == "SH") {
-        // 上海逐笔委托处理逻辑
-        // 上海逐笔委托 --> 限价2 --> 可以入队
+    pending_matches_.expire(last_event_timestamp_, ++event_seq_);
+
+    if constexpr (Policy::kCancelInOrderStream) {
         // 上海逐笔委托 --> 撤单10 --> 要处理乱序的可能
-        // 上海逐笔委托 --> 市价单1/本方最优3 --> 这种订单由于价格未知不会加入Book
         if (order.type == 10) {
             // 处理撤单可能存在的乱序情况
-            if (isOrderExists(order.id)) {
-                onCancelOrder(order.id, order.volume);
-                return;
+            uint32_t slot = order_index_.find(order.id);
+            if (slot != kNullSlot) {
+                onCancelOrder(slot, order.volume);
             } else {
                 // 未找到订单，加入等待撤单事件队列
-                pending_cancel_events_[order.id] = std::move(event);
-                return;
-            }
-
-        } else if (order.type == 2)
-        {   
-            // 添加限价单
-            // 添加后需要在分别在等待成交事件队列和等待撤单事件队列中查找
-            addOrder(order);
-
-            auto trade_it = pending_trade_events_.find(order.id);
-            if (trade_it != pending_trade_events_.end()) {
-                // 处理因乱序而等待的成交
-                for (auto& trade_event : trade_it->second) {
-                    onTrade(order.id, std::get<L2Trade>(trade_event.data).volume, std::get<L2Trade>(trade_event.data).side);
-                }
-                pending_trade_events_.erase(trade_it);
-
+                pending_matches_.park(order.id, PendingKind::CANCEL, order.volume, order.side, order.timestamp, event_seq_);
             }
-
-            auto cancel_it = pending_cancel_events_.find(order.id);
-            if (cancel_it != pending_cancel_events_.end()) {
-                // 处理因乱序而等待的撤单                
-                MarketEvent cancel_event = std::move(cancel_it->second);
-                onCancelOrder(order.id, std::get<L2Order>(cancel_event.data).volume);
-                pending_cancel_events_.erase(cancel_it);
-
-            }
-        } else {
-            // 处理市价与本方最优逐笔委托
-            // 非限价单不入订单簿
             return;
         }
-        
-    } else {
-        // 深圳逐笔委托处理逻辑
-        // 深圳逐笔委托 --> 限价2 --> 可以入队
-        /* 深圳逐笔委托 --> 市价单1/本方最优3 --> 这种订单由于价格未知不会加入Book, 
-            但是会存下id, 用于后续处理trade, 虽然很少是这类单子但是也要处理 */
-        if (order.type == 2) {
-            // 添加限价单
-            // 添加后需要在分别在等待成交事件队列和等待撤单事件队列中查找
-            addOrder(order);
-
-            auto trade_it = pending_trade_events_.find(order.id);
-            if (trade_it != pending_trade_events_.end()) {
-                // 处理因乱序而等待的成交
-                for (auto& trade_event : trade_it->second) {
-                    onTrade(order.id, std::get<L2Trade>(trade_event.data).volume, std::get<L2Trade>(trade_event.data).side);
-                }
-                pending_trade_events_.erase(trade_it);
-
-            }
+    }
 
-            auto cancel_it = pending_cancel_events_.find(order.id);
-            if (cancel_it != pending_cancel_events_.end()) {
-                // 处理因乱序而等待的撤单                
-                MarketEvent cancel_event = std::move(cancel_it->second);
-                onCancelOrder(order.id, std::get<L2Trade>(cancel_event.data).volume);
-                pending_cancel_events_.erase(cancel_it);
- 
-            }
-        } else {
-            // 处理市价与本方最优逐笔委托
-            // 非限价单不入订单簿
-            return;
-        }
+    // 逐笔委托 --> 限价2 --> 可以入队
+    // 逐笔委托 --> 市价单1/本方最优3 --> 这种订单由于价格未知不会加入Book
+    if (order.type == 2) {
+        // 添加限价单
+        // 添加后需要在分别在等待成交事件队列和等待撤单事件队列中查找
+        addOrder(order);
+        applyPendingMatches(order.id);
     }
 }
 
 // 处理逐笔成交
-void OrderBook::handleTradeEvent(const MarketEvent& event){
-    const auto& trade = std::get<L2Trade>(event.data);
+template<typename Policy>
+void OrderBook<Policy>::handleTradeEvent(const MarketEvent& event){
+    const auto& trade = event.trade;
 
     if (trade.timestamp > last_event_timestamp_) {
         last_event_timestamp_ = trade.timestamp;
     }
+    pending_matches_.expire(last_event_timestamp_, ++event_seq_);
 
-    if (trade.type == 1){
+    if (Policy::kCancelInTradeStream && trade.type == 1){
         // 处理深圳撤单逻辑
-        // 如果逐笔成交内成交类型为1, 则代表这一定是深圳的撤单字段
+        // 深圳逐笔成交内成交类型为1, 代表这是撤单字段
         // 处理撤单可能存在的乱序情况
         auto handle_cancel = [&](const int order_id) {
             if (order_id == 0) {
                 return;
             }
 
-            if (isOrderExists(order_id)) {
-                onCancelOrder(order_id, trade.volume);
+            uint32_t slot = order_index_.find(order_id);
+            if (slot != kNullSlot) {
+                onCancelOrder(slot, trade.volume);
                 return;
             } else {
                 // 未找到订单，加入等待撤单事件队列
-                pending_cancel_events_[order_id] = std::move(event);
+                pending_matches_.park(order_id, PendingKind::CANCEL, trade.volume, trade.side, trade.timestamp, event_seq_);
                 return;
             }
         };
@@ -338,13 +436,20 @@ void OrderBook::handleTradeEvent(const MarketEvent& event){
         // 处理成交逻辑
         // 找到buy_id和sell_id对应的订单，减少其数量
         // 处理乱序, 可能找不到订单
-        bool is_exist_buy = isOrderExists(trade.buy_id);
-        bool is_exist_sell = isOrderExists(trade.sell_id);
+        auto park_trade = [&](const int order_id) {
+            pending_matches_.park(order_id, PendingKind::TRADE, trade.volume, trade.side, trade.timestamp, event_seq_);
+        };
+
+        uint32_t buy_slot = order_index_.find(trade.buy_id);
+        uint32_t sell_slot = order_index_.find(trade.sell_id);
+        bool is_exist_buy = buy_slot != kNullSlot;
+        bool is_exist_sell = sell_slot != kNullSlot;
 
         if (is_exist_buy && is_exist_sell) {
             // 成交双方的订单都存在于订单簿中, 直接处理成交
-            onTrade(trade.buy_id, trade.volume, trade.side);
-            onTrade(trade.sell_id, trade.volume, trade.side);
+            onTrade(buy_slot, trade.volume, trade.side);
+            // 买卖编号相同属异常数据, 买方处理后订单可能已移除, 需重新查找
+            onTrade(trade.sell_id == trade.buy_id ? order_index_.find(trade.sell_id) : sell_slot, trade.volume, trade.side);
 
         } else if ((is_exist_buy || is_exist_sell)) {
             // 成交双方只有一方存在于订单簿中
@@ -353,180 +458,175 @@ void OrderBook::handleTradeEvent(const MarketEvent& event){
             // 优先处理存在的一方并加入等待队列, 等待另一方订单到达
             if (is_exist_buy) {
                 // 处理买单
-                onTrade(trade.buy_id, trade.volume, trade.side);    
-                // 将卖单加入等待队列
-                if (market_flag_ == "SH" && trade.side == 2) {
+                onTrade(buy_slot, trade.volume, trade.side);    
+                // 将卖单加入等待队列, 上海卖方为主动方时其委托不在簿中
+                if (Policy::kAggressorOffBook && trade.side == 2) {
                     return;
                 }
                 
-                pending_trade_events_[trade.sell_id].push_back(event);
+                park_trade(trade.sell_id);
             } else {
                 // 处理卖单
-                onTrade(trade.sell_id, trade.volume, trade.side);
-                // 将买单加入等待队列
-                if (market_flag_ == "SH" && trade.side == 1) {
+                onTrade(sell_slot, trade.volume, trade.side);
+                // 将买单加入等待队列, 上海买方为主动方时其委托不在簿中
+                if (Policy::kAggressorOffBook && trade.side == 1) {
                     return;
                 }
 
-                pending_trade_events_[trade.buy_id].push_back(event);
+                park_trade(trade.buy_id);
             }
         } else {
             // 双方订单都不存在于订单簿中, 可能是乱序, 加入等待队列
-            if (market_flag_ == "SH") {
+            if constexpr (Policy::kAggressorOffBook) {
                 if (trade.side == 2) {
-                    pending_trade_events_[trade.buy_id].push_back(event);
+                    park_trade(trade.buy_id);
                 }
 
                 if (trade.side == 1) {
-                    pending_trade_events_[trade.sell_id].push_back(event);
+                    park_trade(trade.sell_id);
                 }
 
                 if (trade.side == 0) {
-                    pending_trade_events_[trade.buy_id].push_back(event);
-                    pending_trade_events_[trade.sell_id].push_back(event);
+                    park_trade(trade.buy_id);
+                    park_trade(trade.sell_id);
                 }
             } else {
-                pending_trade_events_[trade.sell_id].push_back(event);
-                pending_trade_events_[trade.buy_id].push_back(event);
+                park_trade(trade.sell_id);
+                park_trade(trade.buy_id);
             }
         }
     }
 }
 
-// 检查订单是否存在
-bool OrderBook::isOrderExists(const int order_id) const {
-    return order_index_.find(order_id) != order_index_.end();
-}
-
 // 添加订单到订单簿
-void OrderBook::addOrder(const L2Order& order) {
+void OrderBookBase::addOrder(const L2Order& order) {
 
     auto& book = (order.side == 1) ? bids_ : asks_;
-    auto& list = book[order.price];
-
-    list.push_back({order.volume, order.price, order.side, order.id, order.timestamp});
-    order_index_[order.id] = std::prev(list.end());
+    auto* level = book.obtain(order.price);
+    if (level == nullptr) {
+        LOG_WARN(module_name, "[{}] 订单价格无法映射到价格档位, 忽略订单: id={}, price={}", symbol_, order.id, order.price);
+        return;
+    }
 
-    auto& volume_map = (order.side == 1) ? bid_volume_at_price_ : ask_volume_at_price_;
-    volume_map[order.price] += order.volume;
+    uint32_t slot = order_pool_.allocate();
+    OrderRef& order_ref = order_pool_[slot];
+    order_ref.volume = order.volume;
+    order_ref.price = order.price;
+    order_ref.id = order.id;
+    order_ref.timestamp = order.timestamp;
+    order_ref.side = order.side;
+    order_ref.queue_seq = (order.side == 1 && queue_tracker_.tracking(order.price))
+        ? queue_tracker_.onAdd(order.volume, order.timestamp)
+        : QueuePositionTracker::kUntracked;
+
+    level->orders.push_back(order_pool_, slot);
+    level->order_count += 1;
+    order_index_.exchange(order.id, slot);
+
+    book.addVolume(order.price, order.volume);
     //order.info();
 }
 
 // 处理成交
-void OrderBook::onTrade(const int order_id, const int trade_volume, const int trade_side) {
+// slot 为 order_index_ 查找结果, kNullSlot 表示订单不在簿中
+template<typename Policy>
+void OrderBook<Policy>::onTrade(const uint32_t slot, const int trade_volume, const int trade_side) {
 
-    auto reduce_volume = [&](const int id) {
-        auto index_it = order_index_.find(id);
-        if (index_it == order_index_.end()) {
+    auto reduce_volume = [&](const uint32_t order_slot) {
+        if (order_slot == kNullSlot) {
             return;
         }
 
-        int price = index_it->second->price;
-        int side = index_it->second->side;
+        OrderRef& order_ref = order_pool_[order_slot];
+        int price = order_ref.price;
+        int side = order_ref.side;
         
-        if (market_flag_ == "SH") {
-            if (trade_side == side) {
-                // 上海市场买卖方向与成交方向相同的订单不处理封单量, 因为主动成交的一方委托量不会出现在订单簿中
-                return; 
-            }
+        if (Policy::kAggressorOffBook && trade_side == side) {
+            // 上海市场买卖方向与成交方向相同的订单不处理封单量, 因为主动成交的一方委托量不会出现在订单簿中
+            return; 
         }
 
         // 更新订单簿
-        index_it->second->volume -= trade_volume;
+        order_ref.volume -= trade_volume;
+        if (order_ref.queue_seq != QueuePositionTracker::kUntracked && order_ref.volume > 0) {
+            queue_tracker_.onVolumeChange(order_ref.queue_seq, order_ref.volume);
+        }
 
         // 更新价格档位总挂单量
-        if (side == 1) {
-            bid_volume_at_price_[price] -= trade_volume;
-            if (bid_volume_at_price_[price] <= 0) {
-                bid_volume_at_price_.erase(price);
-            }
-        } else {
-            ask_volume_at_price_[price] -= trade_volume;
-            if (ask_volume_at_price_[price] <= 0) {
-                ask_volume_at_price_.erase(price);
-            }
-        }
+        auto& book = (side == 1) ? bids_ : asks_;
+        book.addVolume(price, -trade_volume);
 
-        if (index_it->second->volume <= 0) {
+        if (order_ref.volume <= 0) {
             // 如果订单量为0, 从订单簿和索引中移除
-            removeOrder(id);
+            removeOrder(order_slot);
         }
 
         // LOG_INFO(module_name, "成交订单信息 -- > 订单ID:{}, 订单价格:{}, 订单方向:{}", 
-        //     id, price, side);
+        //     order_ref.id, price, side);
     };
     
-    reduce_volume(order_id);
+    reduce_volume(slot);
 }
 
 // 处理撤单
-void OrderBook::onCancelOrder(const int order_id, const int cancel_volume) {
-    auto index_it = order_index_.find(order_id);
-    if (index_it == order_index_.end()) {
+void OrderBookBase::onCancelOrder(const uint32_t slot, const int cancel_volume) {
+    if (slot == kNullSlot) {
         return;
     }
     
     // 更新订单簿
-    index_it->second->volume -= cancel_volume;
+    OrderRef& order_ref = order_pool_[slot];
+    order_ref.volume -= cancel_volume;
+    if (order_ref.queue_seq != QueuePositionTracker::kUntracked && order_ref.volume > 0) {
+        queue_tracker_.onVolumeChange(order_ref.queue_seq, order_ref.volume);
+    }
 
-    int price = index_it->second->price;
-    int side = index_it->second->side;
+    int price = order_ref.price;
+    int side = order_ref.side;
 
     // 更新价格档位总挂单量
-    if (side == 1) {
-        bid_volume_at_price_[price] -= cancel_volume;
-        if (bid_volume_at_price_[price] <= 0) {
-            bid_volume_at_price_.erase(price);
-        }
-    } else {
-        ask_volume_at_price_[price] -= cancel_volume;
-        if (ask_volume_at_price_[price] <= 0) {
-            ask_volume_at_price_.erase(price);
-        }
-    }
+    auto& book = (side == 1) ? bids_ : asks_;
+    book.addVolume(price, -cancel_volume);
     
-    if (index_it->second->volume <= 0) {
+    if (order_ref.volume <= 0) {
         // 如果订单量为0, 从订单簿和索引中移除
-        removeOrder(order_id);
+        removeOrder(slot);
     }
 }
 
 // 从订单簿中移除订单
-void OrderBook::removeOrder(const int order_id) {
+void OrderBookBase::removeOrder(const uint32_t slot) {
 
-    // 查找订单, 返回键值对迭代器
-    auto index_it = order_index_.find(order_id);
-    if (index_it == order_index_.end()) {
-        // 未找到订单
-        return;
-    }
-    
-    // 获取订单引用指针
-    auto order_iter = index_it->second;
+    // 获取订单节点
+    const OrderRef& order_ref = order_pool_[slot];
 
     // 取出订单信息
-    int price = order_iter->price;
-    int side = order_iter->side;
-    int volume = order_iter->volume;
+    int order_id = order_ref.id;
+    int price = order_ref.price;
+    int side = order_ref.side;
+    int volume = order_ref.volume;
 
     // 拿到买方盘口或者卖方盘口
     auto& book = (side == 1) ? bids_ : asks_;
 
-    // 拿到对应价格档位键值对迭代器
-    auto price_it = book.find(price);
-    if (price_it == book.end()) {
+    // 拿到对应价格档位
+    auto* level = book.find(price);
+    if (level == nullptr) {
         // 未找到价格档位，数据异常
         return;
     } else {
-        auto& price_level_list = price_it->second;
-
         // 从价格档位列表中移除订单,从索引中移除订单
-        price_level_list.erase(order_iter);
-        order_index_.erase(index_it);
+        bool tracked = order_ref.queue_seq != QueuePositionTracker::kUntracked;
+        if (tracked) {
+            queue_tracker_.onRemove(order_ref.queue_seq);
+        }
+        level->orders.erase(order_pool_, slot);
+        level->order_count -= 1;
+        order_pool_.release(slot);
+        order_index_.erase(order_id);
 
-        // 如果该价格档位没有订单了, 从订单簿中移除该价格档位
-        if (price_level_list.empty()) {
-            book.erase(price_it);
+        if (tracked && queue_tracker_.needsCompaction()) {
+            compactQueueTracker();
         }
 
         // LOG_INFO(module_name, "[{}] Remove order success: id={}", symbol_, order_id);
@@ -534,52 +634,56 @@ void OrderBook::removeOrder(const int order_id) {
     }
 }
 
-// 打印订单簿前 N 档
-void OrderBook::printOrderBook(int level_num) const {
+// 由处理线程调用: 发布前 BookSnapshot::kDepth 档盘口与计数器
+void OrderBookBase::publishSnapshot() {
+    BookSnapshot snap{};
 
-    LOG_INFO(module_name, "===== OrderBook Top {} for {} =====", level_num, symbol_);
-    
-    // 卖盘（Asks）：价格从低到高（asks_ 是升序 map）
-    LOG_INFO(module_name, "Asks (Sell):");
+    for (int price = bids_.highestPrice();
+         price != kInvalidPrice && snap.bid_levels < BookSnapshot::kDepth;
+         price = bids_.nextLower(price)) {
+        snap.bids[snap.bid_levels++] = {price, bids_.volumeAt(price)};
+    }
+
+    for (int price = asks_.lowestPrice();
+         price != kInvalidPrice && snap.ask_levels < BookSnapshot::kDepth;
+         price = asks_.nextHigher(price)) {
+        snap.asks[snap.ask_levels++] = {price, asks_.volumeAt(price)};
+    }
 
-    std::vector<std::pair<int, int>> ask_levels;
+    snap.fengdan_volume = fengdan_volume_;
+    snap.max_bid_volume = max_bid_volume_;
+    snap.last_event_timestamp = last_event_timestamp_;
+    snap.loop_count = loop_count_;
+    snap.live = isLive();
+
+    const auto& pool_stats = order_pool_.stats();
+    snap.pool_live = pool_stats.live;
+    snap.pool_peak = pool_stats.peak;
+    snap.pool_capacity = pool_stats.capacity;
+    snap.pool_chunk_allocations = pool_stats.chunk_allocations;
+    snap.index_stats = order_index_.stats();
+    snap.pending_stats = pending_matches_.stats();
+
+    snapshot_.publish(snap);
+}
 
-    int ask_count = 0;
-    for (auto it = ask_volume_at_price_.begin(); 
-         it != ask_volume_at_price_.end() && ask_count < level_num; 
-         ++it, ++ask_count) {
+// 打印订单簿前 N 档, 只读取已发布的快照
+void OrderBookBase::printOrderBook(int level_num) const {
+    const BookSnapshot snap = snapshot_.read();
+    level_num = std::min(level_num, BookSnapshot::kDepth);
 
-            ask_levels.emplace_back(it->first, it->second);
-    }
+    LOG_INFO(module_name, "===== OrderBook Top {} for {} =====", level_num, symbol_);
     
-    for (auto it = ask_levels.rbegin(); it != ask_levels.rend(); ++it) {
-
-        double price = it->first / 10000.0;
-        int total_vol = it->second;
-        LOG_INFO(module_name, "  {:8.4f}  {:10}", price, total_vol);
+    // 卖盘（Asks）：价格从低到高取前 N 档, 倒序打印
+    LOG_INFO(module_name, "Asks (Sell):");
+    for (int i = std::min(level_num, snap.ask_levels) - 1; i >= 0; --i) {
+        LOG_INFO(module_name, "  {:8.4f}  {:10}", snap.asks[i].price / 10000.0, snap.asks[i].volume);
     }
 
-    // 买盘（Bids）：价格从高到低（bid_volume_at_price_ 是升序 map，需反向）
+    // 买盘（Bids）：价格从高到低
     LOG_INFO(module_name, "Bids (Buy):");
-    int bid_count = 0;
-    for (auto it = bid_volume_at_price_.rbegin(); 
-         it != bid_volume_at_price_.rend() && bid_count < level_num; 
-         ++it) {
-        double price = it->first / 10000.0;
-        int total_vol = it->second;
-        LOG_INFO(module_name, "  {:8.4f}  {:10}", price, total_vol);
-        ++bid_count;
-    }
-
-    int total_bid_list_size = 0;
-    for (const auto& [price, order_list] : bids_) {
-        
-        total_bid_list_size += order_list.size();
-    }
-
-    int total_ask_list_size = 0;
-    for (const auto& [price, order_list] : asks_) {
-        total_ask_list_size += order_list.size();
+    for (int i = 0; i < std::min(level_num, snap.bid_levels); ++i) {
+        LOG_INFO(module_name, "  {:8.4f}  {:10}", snap.bids[i].price / 10000.0, snap.bids[i].volume);
     }
 
 
@@ -618,22 +722,11 @@ void OrderBook::printOrderBook(int level_num) const {
     //     }
     // }
 
-    // for (auto it = pending_trade_events_.begin(); it != pending_trade_events_.end(); ++it) {
-    //     LOG_INFO(module_name, "等待成交事件 - ID: {}", it->first);
-    // }
-
-    // for (auto it = pending_cancel_events_.begin(); it != pending_cancel_events_.end(); ++it) {
-    //     LOG_INFO(module_name, "等待撤单事件 - ID: {}", it->first);
-    // }
-
     // LOG_INFO(module_name, "买盘价格订单总数量 {}", total_bid_list_size);
     // LOG_INFO(module_name, "卖盘价格订单总数量 {}", total_ask_list_size);
-    // LOG_INFO(module_name, "历史事件去重集合大小: {}", history_order_id_.size());
-    // LOG_INFO(module_name, "等待成交事件队列大小: {}", pending_trade_events_.size());
-    // LOG_INFO(module_name, "等待撤单事件队列大小: {}", pending_cancel_events_.size());
     // LOG_INFO(module_name, "订单索引大小: {}", order_index_.size());
-    // LOG_INFO(module_name, "买盘档位数量: {}", bids_.size());
-    // LOG_INFO(module_name, "卖盘档位数量: {}", asks_.size());
+    // LOG_INFO(module_name, "买盘档位数量: {}", bids_.activeLevels());
+    // LOG_INFO(module_name, "卖盘档位数量: {}", asks_.activeLevels());
     // LOG_INFO(module_name, "历史涨停封单比例数量: {}", limit_up_fengdan_ratios_.size());
 
     std::string position_str;
@@ -641,11 +734,11 @@ void OrderBook::printOrderBook(int level_num) const {
     auto opt_queue_monitor_info = queueMonitorInfo_ref_.get(symbol_);
     if (opt_queue_monitor_info) {
         auto queue_monitor_info = *opt_queue_monitor_info;
-        if (order_position_index.size() == queue_monitor_info.size()) {
+        if (order_position_index->size() == queue_monitor_info.size()) {
 
             bool first = true;
             int i = 0;
-            for (auto& position_index : order_position_index) {
+            for (auto& position_index : *order_position_index) {
                 if (!first) {
                     position_str += "|";
                 }
@@ -664,29 +757,27 @@ void OrderBook::printOrderBook(int level_num) const {
     }
     
     LOG_INFO(module_name, "订单位置索引: {}", position_str);
-    LOG_INFO(module_name, "当前封单量: {}", fengdan_volume_);
-    LOG_INFO(module_name, "最大封单量: {}", max_bid_volume_);
-    LOG_INFO(module_name, "最后订单时间: {}", last_event_timestamp_);
-    LOG_INFO(module_name, "当前循环数: {}", loop_count_);
+    const auto& index_stats = snap.index_stats;
+    LOG_INFO(module_name, "订单节点池: 在簿 {}, 峰值 {}, 容量 {}, 分配块 {} 次",
+        snap.pool_live, snap.pool_peak, snap.pool_capacity, snap.pool_chunk_allocations);
+    LOG_INFO(module_name, "订单索引: 分页 {} (页数 {}), 哈希 {} (容量 {})",
+        index_stats.direct_entries, index_stats.live_pages, index_stats.hashed_entries, index_stats.hash_capacity);
+    const auto& pending_stats = snap.pending_stats;
+    LOG_INFO(module_name, "乱序暂存: 当前 {}, 峰值 {}, 累计 {}, 补处理 {}, 超期丢弃 {}, 撤单覆盖 {}",
+        pending_stats.resident, pending_stats.peak, pending_stats.parked,
+        pending_stats.matched_late, pending_stats.expired, pending_stats.replaced);
+    LOG_INFO(module_name, "当前封单量: {}", snap.fengdan_volume);
+    LOG_INFO(module_name, "最大封单量: {}", snap.max_bid_volume);
+    LOG_INFO(module_name, "最后订单时间: {}", snap.last_event_timestamp);
+    LOG_INFO(module_name, "当前循环数: {}", snap.loop_count);
     LOG_INFO(module_name, "=========================================");
 
 }
 
-// 循环打印
-void OrderBook::printloop(int level_num) {
-    while (running_) {
-        {
-            std::lock_guard<std::mutex> lock(mtx_);
-            printOrderBook(level_num);
-        }
-        std::this_thread::sleep_for(std::chrono::seconds(1)); // 每3秒打印一次
-    }
-}
-
 // 检查涨停撤单情况
-void OrderBook::checkLimitUpWithdrawal(int timestamp) {
+void OrderBookBase::checkLimitUpWithdrawal(int timestamp) {
     // 如果没有买盘则直接返回
-    if (bid_volume_at_price_.empty()) {
+    if (bids_.empty()) {
         return;
     }
 
@@ -696,17 +787,13 @@ void OrderBook::checkLimitUpWithdrawal(int timestamp) {
     int best_bid_volume = 0;
     int best_ask_volume = 0;
 
-    auto best_bid_it = bid_volume_at_price_.rbegin();
-    auto best_ask_it = ask_volume_at_price_.rbegin();
-
-    if (best_bid_it != bid_volume_at_price_.rend()){
-        best_bid_price = best_bid_it->first;
-        best_bid_volume = best_bid_it->second;
-    }
+    // 卖盘取有量的最高价, 与原 std::map rbegin() 的取法一致
+    best_bid_price = bids_.highestPrice();
+    best_bid_volume = bids_.volumeAt(best_bid_price);
 
-    if (best_ask_it != ask_volume_at_price_.rend()){
-        best_ask_price = best_ask_it->first;
-        best_ask_volume = best_ask_it->second;
+    if (!asks_.empty()){
+        best_ask_price = asks_.highestPrice();
+        best_ask_volume = asks_.volumeAt(best_ask_price);
     }
 
     // 涨停价假设
@@ -725,14 +812,7 @@ void OrderBook::checkLimitUpWithdrawal(int timestamp) {
     }
 
     // 计算买一价位及以下的总卖单量
-    int total_ask_volume_at_or_below_best_bid = 0;
-    for (auto it = ask_volume_at_price_.begin(); it != ask_volume_at_price_.end(); ++it) {
-        if (it->first <= best_bid_price) {
-            total_ask_volume_at_or_below_best_bid += it->second;
-        } else {
-            break;
-        }
-    }
+    int total_ask_volume_at_or_below_best_bid = static_cast<int>(asks_.volumeAtOrBelow(best_bid_price));
 
     // 计算封单量
     fengdan_volume_ = best_bid_volume - total_ask_volume_at_or_below_best_bid;
@@ -748,24 +828,10 @@ void OrderBook::checkLimitUpWithdrawal(int timestamp) {
         max_bid_volume_ = fengdan_volume_;
     }
 
-    // 更新封单比例的时间窗口
+    // 更新封单比例和封单量的时间窗口, 移出 3s 之前的记录
     int old_event_timestamp = last_event_timestamp_ - 3000;
-    for (auto it = limit_up_fengdan_ratios_.begin(); it != limit_up_fengdan_ratios_.end(); ++it) {
-        if (it->first > old_event_timestamp) {
-            break;
-        }
-
-        limit_up_fengdan_ratios_.erase(it);
-    }
-
-    // 更新封单量的时间窗口
-    for (auto it = limit_up_fengdan_volumes_.begin(); it != limit_up_fengdan_volumes_.end(); ++it) {
-        if (it->first > old_event_timestamp) {
-            break;
-        }
-
-        limit_up_fengdan_volumes_.erase(it);
-    }
+    limit_up_fengdan_ratios_.evictUpTo(old_event_timestamp);
+    limit_up_fengdan_volumes_.evictUpTo(old_event_timestamp);
 
     // 计算当前封单比例
     double current_ratio = (max_bid_volume_ > 0) ? static_cast<double>(fengdan_volume_) / max_bid_volume_ : 0.0;
@@ -774,11 +840,7 @@ void OrderBook::checkLimitUpWithdrawal(int timestamp) {
     double ratio_change = 0.0;
     double max_ratio_in_window = 0.0;
     if (!limit_up_fengdan_ratios_.empty()) {
-        for (const auto& [timestamp, ratio] : limit_up_fengdan_ratios_) {
-            if (ratio > max_ratio_in_window) {
-                max_ratio_in_window = ratio;
-            }
-        }
+        max_ratio_in_window = std::max(max_ratio_in_window, limit_up_fengdan_ratios_.query());
         ratio_change = max_ratio_in_window - current_ratio;
     }
 
@@ -786,37 +848,13 @@ void OrderBook::checkLimitUpWithdrawal(int timestamp) {
     double volume_change_rate = 0.0;
     int max_volume_in_window = 0;
     if (!limit_up_fengdan_volumes_.empty()) {
-        for (const auto& [timestamp, volume] : limit_up_fengdan_volumes_) {
-            if (volume > max_volume_in_window) {
-                max_volume_in_window = volume;
-            }
-        }
+        max_volume_in_window = std::max(max_volume_in_window, limit_up_fengdan_volumes_.query());
         volume_change_rate = (max_volume_in_window > 0) ? static_cast<double>(max_volume_in_window - fengdan_volume_) / max_volume_in_window : 0.0;
     }
 
-    // 记录当前封单比例
-    auto it_ratio = limit_up_fengdan_ratios_.find(timestamp);
-    if (it_ratio == limit_up_fengdan_ratios_.end()) {
-        // 键不存在，直接插入新键值对
-        limit_up_fengdan_ratios_[timestamp] = current_ratio;
-    } else {
-        // 键存在，检查新值是否更大
-        if (current_ratio > it_ratio->second) {
-            it_ratio->second = current_ratio; // 更新值
-        }
-    }
-
-    // 记录当前封单量
-    auto it_volume = limit_up_fengdan_volumes_.find(timestamp);
-    if (it_volume == limit_up_fengdan_volumes_.end()) {
-        // 键不存在，直接插入新键值对
-        limit_up_fengdan_volumes_[timestamp] = fengdan_volume_;
-    } else {
-        // 键存在，检查新值是否更大
-        if (fengdan_volume_ > it_volume->second) {
-            it_volume->second = fengdan_volume_; // 更新值
-        }
-    }
+    // 记录当前封单比例和封单量, 同一时间戳的多条记录取最大值与合并为一条等价
+    limit_up_fengdan_ratios_.push(timestamp, current_ratio);
+    limit_up_fengdan_volumes_.push(timestamp, fengdan_volume_);
 
     // 撤单策略1
     auto cancel_strategy_1 = [&](){
@@ -884,55 +922,39 @@ void OrderBook::checkLimitUpWithdrawal(int timestamp) {
 
     // 查找涨停板排单位置
     auto find_order_in_queue = [&]() {
-        // 清空 vector 数组
-        std::vector<std::vector<int>> order_position_index;
-
-        auto opt_queue_monitor_info = queueMonitorInfo_ref_.get(symbol_);
+        // 监控挂单量只在前端修改时变化, 按版本号判断是否需要重新读取
+        uint64_t monitor_version = queueMonitorInfo_ref_.version();
+        if (monitor_version != queue_monitor_version_) {
+            queue_monitor_volumes_ = queueMonitorInfo_ref_.get(symbol_);
+            queue_monitor_version_ = monitor_version;
+            untrackQueuePrice();
+        }
 
-        if (!opt_queue_monitor_info) {
+        if (!queue_monitor_volumes_) {
             return;
         }
-        auto queue_monitor_info = *opt_queue_monitor_info;
 
         // 查找涨停板价格
-        auto it = bids_.find(fake_limit_up_price);
+        auto* level = bids_.find(fake_limit_up_price);
 
-        if (it == bids_.end()) {
+        if (level == nullptr || level->orders.empty()) {
             return;
         }
 
-        // 获取价格档位的订单
-        std::list<OrderRef>& orders = it -> second;
-
-        int TIME_CUTOFF = 33301000;
-        // 遍历挂单量
-        for (int order_vol : queue_monitor_info) {
-            int idx = 0;
-            std::vector<int> position_index;
-            // 遍历订单
-            for (const auto& order : orders){
-                // 测试打印数据
-                // LOG_INFO(module_name, "volume {}, order timestamp {}", order.volume, order.timestamp);
-
-                // 如果时间超过截止时间, 跳出循环
-                if (order.timestamp > TIME_CUTOFF) break;
-
-                // 如果订单量匹配, 记录位置
-                if (order.volume == order_vol){
-                    position_index.push_back(idx + 1);
-                }
-
-                ++idx;
-            }
-            order_position_index.push_back(position_index);
+        // 涨停价变化时按新价位的队列重建排位
+        if (!queue_tracker_.tracking(fake_limit_up_price)) {
+            trackQueuePrice(fake_limit_up_price, *queue_monitor_volumes_);
         }
 
-        order_position_index_db_.update(order_position_index);
+        if (queue_tracker_.changed()) {
+            queue_tracker_.collect(queue_positions_);
+            order_position_index_db_.update(queue_positions_);
+        }
 
         if (loop_count_ % 10 == 0){
             queueSendServer_ref_.send(formatQueueMessage(
                 symbol_, 
-                order_position_index
+                queue_positions_
             ));
         }
 
@@ -951,3 +973,82 @@ void OrderBook::checkLimitUpWithdrawal(int timestamp) {
     }
 }
 
+// 委托到达后, 补处理因乱序而等待的成交, 再补处理等待的撤单
+template<typename Policy>
+void OrderBook<Policy>::applyPendingMatches(int order_id) {
+    bool has_cancel = false;
+    int cancel_volume = 0;
+    pending_matches_.take(order_id, [&](const PendingMatch& match) {
+        if (match.kind == PendingKind::TRADE) {
+            onTrade(order_index_.find(order_id), match.volume, match.side);
+        } else {
+            has_cancel = true;
+            cancel_volume = match.volume;
+        }
+    });
+
+    if (has_cancel) {
+        onCancelOrder(order_index_.find(order_id), cancel_volume);
+    }
+}
+
+// 开始跟踪 price 买盘价位的排队位置, 原跟踪价位的订单不再跟踪
+void OrderBookBase::trackQueuePrice(int price, const std::vector<int>& monitor_volumes) {
+    untrackQueuePrice();
+
+    queue_tracker_.reset(price, monitor_volumes, kQueueTimeCutoff);
+    if (auto* level = bids_.find(price)) {
+        for (uint32_t slot = level->orders.head; slot != kNullSlot; slot = order_pool_[slot].next) {
+            OrderRef& order_ref = order_pool_[slot];
+            order_ref.queue_seq = queue_tracker_.onAdd(order_ref.volume, order_ref.timestamp);
+        }
+    }
+}
+
+// 跟踪价位上已移除的订单过多时, 按当前队列重新编号, 排位不变
+void OrderBookBase::compactQueueTracker() {
+    queue_tracker_.restart();
+    if (auto* level = bids_.find(queue_tracker_.price())) {
+        for (uint32_t slot = level->orders.head; slot != kNullSlot; slot = order_pool_[slot].next) {
+            OrderRef& order_ref = order_pool_[slot];
+            order_ref.queue_seq = queue_tracker_.onAdd(order_ref.volume, order_ref.timestamp);
+        }
+    }
+}
+
+void OrderBookBase::untrackQueuePrice() {
+    if (!queue_tracker_.active()) {
+        return;
+    }
+
+    if (auto* level = bids_.find(queue_tracker_.price())) {
+        for (uint32_t slot = level->orders.head; slot != kNullSlot; slot = order_pool_[slot].next) {
+            order_pool_[slot].queue_seq = QueuePositionTracker::kUntracked;
+        }
+    }
+    queue_tracker_.deactivate();
+}
+
+template class OrderBook<SsePolicy>;
+template class OrderBook<SzsePolicy>;
+
+std::unique_ptr<OrderBookBase> makeOrderBook(
+    const std::string symbol,
+    const int vol_flag,
+    const PipelineConfig& pipeline_config,
+    const PriceBandConfig& price_band_config,
+    SendServer& sendServer_ref,
+    SendServer& queueSendServer_ref,
+    AutoSaveJsonMap<std::string, std::vector<int>>& cancelMonitorInfo_ref,
+    AutoSaveJsonMap<std::string, std::unordered_map<int, int>>& sellMonitorInfo_ref,
+    AutoSaveJsonMap<std::string, std::vector<int>>& queueMonitorInfo_ref
+) {
+    if (isSseSymbol(symbol)) {
+        return std::make_unique<OrderBook<SsePolicy>>(
+            symbol, vol_flag, pipeline_config, price_band_config, sendServer_ref, queueSendServer_ref,
+            cancelMonitorInfo_ref, sellMonitorInfo_ref, queueMonitorInfo_ref);
+    }
+    return std::make_unique<OrderBook<SzsePolicy>>(
+        symbol, vol_flag, pipeline_config, price_band_config, sendServer_ref, queueSendServer_ref,
+        cancelMonitorInfo_ref, sellMonitorInfo_ref, queueMonitorInfo_ref);
+}
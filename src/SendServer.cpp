@@ -5,8 +5,8 @@
 #include <windows.h>
 
 
-SendServer::SendServer(const std::string& pipe_name)
-    : full_pipe_name_("\\\\.\\pipe\\" + pipe_name) {
+SendServer::SendServer(const std::string& pipe_name, const ThreadRole& role)
+    : full_pipe_name_("\\\\.\\pipe\\" + pipe_name), role_(role) {
     InitializeCriticalSection(&mutex_);
     server_thread_ = std::thread(&SendServer::runServer, this);
 
@@ -45,6 +45,8 @@ void SendServer::stop() {
 }
 
 void SendServer::runServer() {
+    role_.pinThread();
+
     while (running_) {
         HANDLE hPipe = CreateNamedPipeA(
             full_pipe_name_.c_str(),
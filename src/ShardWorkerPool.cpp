@@ -0,0 +1,95 @@
+#include "ShardWorkerPool.h"
+#include "Logger.h"
+#include "OrderBook.h"
+
+#include <algorithm>
+#include <chrono>
+
+static const char* module_name = "ShardWorkerPool";
+
+ShardWorkerPool::ShardWorkerPool(size_t worker_count, const ThreadRole& role) : role_(role) {
+    worker_count = std::max<size_t>(worker_count, 1);
+
+    workers_.reserve(worker_count);
+    for (size_t i = 0; i < worker_count; ++i) {
+        auto worker = std::make_unique<Worker>();
+        worker->index = i;
+        worker->ready.waiter.setMode(role_.wait_mode);
+        worker->ready.waiter.setSpinCount(role_.spin_count);
+        workers_.push_back(std::move(worker));
+    }
+
+    // 全部 Worker 创建完成后再启动线程, attach 可能在线程启动后立即发生
+    for (auto& worker : workers_) {
+        worker->thread = std::thread(&ShardWorkerPool::run, this, std::ref(*worker));
+    }
+
+    LOG_INFO(module_name, "OrderBook 处理线程数: {}, 等待方式: {}, 绑定核心: {}",
+        worker_count, waitModeName(role_.wait_mode), coreListName(role_.cores));
+}
+
+ShardWorkerPool::~ShardWorkerPool() {
+    stop();
+}
+
+void ShardWorkerPool::attach(OrderBookBase* book, SymbolId symbol_id) {
+    Worker& worker = *workers_[symbol_id % workers_.size()];
+    {
+        std::lock_guard<std::mutex> lock(worker.books_mtx);
+        worker.books.push_back(book);
+    }
+    book->bindReadyQueue(&worker.ready);
+}
+
+void ShardWorkerPool::run(Worker& worker) {
+    role_.pinThread(worker.index);
+
+    const auto timer_interval = std::chrono::seconds(1);
+    auto next_timer = std::chrono::steady_clock::now() + timer_interval;
+
+    while (running_) {
+        OrderBookBase* book = nullptr;
+        if (worker.ready.books.try_dequeue(book)) {
+            // 先清除调度标记再处理, 处理期间新到的事件会重新调度, 不会遗漏
+            book->clearScheduled();
+            if (book->poll()) {
+                book->schedule();
+            }
+        } else {
+            auto remaining = std::chrono::duration_cast<std::chrono::microseconds>(next_timer - std::chrono::steady_clock::now());
+            if (remaining.count() > 0) {
+                worker.ready.waiter.waitUntilFor([&] {
+                    return worker.ready.books.size_approx() > 0 || !running_;
+                }, remaining);
+            }
+        }
+
+        // 定时任务: 打印订单簿等, 与事件处理在同一线程, 无需与处理过程互斥
+        auto now = std::chrono::steady_clock::now();
+        if (now >= next_timer) {
+            next_timer = now + timer_interval;
+            std::lock_guard<std::mutex> lock(worker.books_mtx);
+            for (OrderBookBase* owned : worker.books) {
+                owned->onTimer();
+            }
+        }
+    }
+}
+
+void ShardWorkerPool::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+
+    LOG_INFO(module_name, "停止 OrderBook 处理线程");
+
+    for (auto& worker : workers_) {
+        worker->ready.waiter.notify();
+    }
+
+    for (auto& worker : workers_) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+}
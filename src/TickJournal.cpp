@@ -0,0 +1,447 @@
+#include "TickJournal.h"
+#include "DataStruct.h"
+#include "FileOperator.h"
+#include "Logger.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <unordered_map>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static const char* module_name = "TickJournal";
+
+namespace {
+
+constexpr char kSegmentMagic[4] = {'L', '2', 'T', 'J'};
+constexpr size_t kMaxFreeBlocks = 64;
+
+std::string segmentFileName(uint32_t index) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "segment_%06u.tj", index);
+    return name;
+}
+
+// 内存映射文件, 写模式创建时按指定大小预分配, 关闭时截断到实际写入长度
+class MappedFile {
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile() { close(size_); }
+
+    bool create(const std::string& path, size_t size) {
+#ifdef _WIN32
+        file_ = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+            CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE) return false;
+
+        mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READWRITE,
+            static_cast<DWORD>(static_cast<uint64_t>(size) >> 32), static_cast<DWORD>(size & 0xFFFFFFFFu), nullptr);
+        if (!mapping_) { close(0); return false; }
+
+        data_ = static_cast<char*>(MapViewOfFile(mapping_, FILE_MAP_WRITE, 0, 0, size));
+#else
+        fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd_ < 0) return false;
+        if (::ftruncate(fd_, static_cast<off_t>(size)) != 0) { close(0); return false; }
+
+        void* addr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        data_ = addr == MAP_FAILED ? nullptr : static_cast<char*>(addr);
+#endif
+        if (!data_) { close(0); return false; }
+        size_ = size;
+        writable_ = true;
+        return true;
+    }
+
+    bool openReadOnly(const std::string& path) {
+        std::error_code ec;
+        size_t size = static_cast<size_t>(std::filesystem::file_size(path, ec));
+        if (ec || size == 0) return false;
+#ifdef _WIN32
+        file_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE) return false;
+
+        mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping_) { close(0); return false; }
+
+        data_ = static_cast<char*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, size));
+#else
+        fd_ = ::open(path.c_str(), O_RDONLY);
+        if (fd_ < 0) return false;
+
+        void* addr = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd_, 0);
+        data_ = addr == MAP_FAILED ? nullptr : static_cast<char*>(addr);
+#endif
+        if (!data_) { close(0); return false; }
+        size_ = size;
+        writable_ = false;
+        return true;
+    }
+
+    // 解除映射并关闭文件, 写模式下把文件截断为 used_bytes
+    void close(size_t used_bytes) {
+#ifdef _WIN32
+        if (data_) {
+            if (writable_) FlushViewOfFile(data_, 0);
+            UnmapViewOfFile(data_);
+        }
+        if (mapping_) CloseHandle(mapping_);
+        if (file_ != INVALID_HANDLE_VALUE) {
+            if (writable_ && data_) {
+                LARGE_INTEGER end;
+                end.QuadPart = static_cast<LONGLONG>(used_bytes);
+                SetFilePointerEx(file_, end, nullptr, FILE_BEGIN);
+                SetEndOfFile(file_);
+            }
+            CloseHandle(file_);
+        }
+        mapping_ = nullptr;
+        file_ = INVALID_HANDLE_VALUE;
+#else
+        if (data_) {
+            if (writable_) ::msync(data_, size_, MS_SYNC);
+            ::munmap(data_, size_);
+        }
+        if (fd_ >= 0) {
+            if (writable_ && data_) {
+                if (::ftruncate(fd_, static_cast<off_t>(used_bytes)) != 0) {
+                    LOG_WARN(module_name, "段文件截断失败");
+                }
+            }
+            ::close(fd_);
+        }
+        fd_ = -1;
+#endif
+        data_ = nullptr;
+        size_ = 0;
+        writable_ = false;
+    }
+
+    char* data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+#ifdef _WIN32
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = nullptr;
+#else
+    int fd_ = -1;
+#endif
+    char* data_ = nullptr;
+    size_t size_ = 0;
+    bool writable_ = false;
+};
+
+} // namespace
+
+class TickJournal::Segment : public MappedFile {};
+
+// ------------------------------------------------------------
+// TickJournalBatch
+// ------------------------------------------------------------
+
+void TickJournalBatch::append(uint8_t stream, SymbolId symbol_id, int64_t recv_time_us, std::string_view text) {
+    if (text.size() > UINT16_MAX) {
+        LOG_WARN(module_name, "记录过长({} 字节), 不写入日志", text.size());
+        return;
+    }
+
+    TickJournalRecordHeader header{};
+    header.length = static_cast<uint16_t>(text.size());
+    header.stream = stream;
+    header.symbol_id = symbol_id;
+    header.recv_time_us = recv_time_us;
+
+    bytes_.append(reinterpret_cast<const char*>(&header), sizeof(header));
+    bytes_.append(text.data(), text.size());
+}
+
+// ------------------------------------------------------------
+// TickJournal
+// ------------------------------------------------------------
+
+TickJournal::TickJournal(const std::string& base_dir, size_t segment_bytes, const ThreadRole& role)
+    : segment_bytes_(std::max<size_t>(segment_bytes, 1 << 20)),
+      role_(role)
+{
+    std::tm now_tm = {};
+    std::time_t now_c = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    safe_localtime(now_c, now_tm);
+
+    char session_name[32];
+    std::strftime(session_name, sizeof(session_name), "%Y%m%d_%H%M%S", &now_tm);
+    session_dir_ = base_dir + "/" + session_name;
+
+    std::error_code ec;
+    std::filesystem::create_directories(session_dir_, ec);
+    if (ec) {
+        LOG_ERROR(module_name, "无法创建日志目录 {}: {}", session_dir_, ec.message());
+    }
+
+    LOG_INFO(module_name, "逐笔日志目录: {}, 段大小: {} MB", session_dir_, segment_bytes_ >> 20);
+
+    writer_thread_ = std::thread(&TickJournal::writerLoop, this);
+}
+
+TickJournal::~TickJournal() {
+    stop();
+}
+
+int64_t TickJournal::nowMicros() {
+    using namespace std::chrono;
+    return duration_cast<microseconds>(system_clock::now().time_since_epoch()).count();
+}
+
+void TickJournal::submit(TickJournalBatch& batch) {
+    if (batch.empty()) {
+        return;
+    }
+
+    pending_blocks_.enqueue(std::move(batch.bytes_));
+
+    // 换入一个回收的缓冲区, 保留容量
+    if (!free_blocks_.try_dequeue(batch.bytes_)) {
+        batch.bytes_ = std::string();
+    }
+    batch.bytes_.clear();
+}
+
+void TickJournal::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+
+    LOG_INFO(module_name, "停止 TickJournal");
+
+    if (writer_thread_.joinable()) {
+        writer_thread_.join();
+    }
+}
+
+void TickJournal::writerLoop() {
+    role_.pinThread();
+
+    std::vector<std::string> blocks(16);
+
+    while (true) {
+        size_t count = pending_blocks_.wait_dequeue_bulk_timed(blocks.data(), blocks.size(), std::chrono::milliseconds(200));
+        for (size_t i = 0; i < count; ++i) {
+            writeBlock(blocks[i]);
+            if (free_blocks_.size_approx() < kMaxFreeBlocks) {
+                free_blocks_.enqueue(std::move(blocks[i]));
+            }
+        }
+
+        // 停止后写完剩余数据再退出
+        if (count == 0 && !running_.load()) {
+            break;
+        }
+    }
+
+    closeSegment();
+    LOG_INFO(module_name, "逐笔日志共写入 {} 条记录, 丢弃 {} 条", record_count_, dropped_records_);
+}
+
+void TickJournal::writeBlock(const std::string& block) {
+    size_t offset = 0;
+    while (offset + sizeof(TickJournalRecordHeader) <= block.size()) {
+        TickJournalRecordHeader header;
+        std::memcpy(&header, block.data() + offset, sizeof(header));
+        const char* payload = block.data() + offset + sizeof(header);
+        offset += sizeof(header) + header.length;
+
+        const size_t record_bytes = sizeof(header) + header.length;
+        std::string_view symbol = SymbolTable::instance().name(header.symbol_id);
+        const bool needs_definition = header.symbol_id >= defined_symbols_.size() || !defined_symbols_[header.symbol_id];
+        const size_t required = record_bytes + (needs_definition ? sizeof(header) + symbol.size() : 0);
+
+        if (!ensureSpace(required)) {
+            ++dropped_records_;
+            continue;
+        }
+
+        // ensureSpace 可能滚动到新段, 需重新判断是否写过定义
+        if (header.symbol_id >= defined_symbols_.size()) {
+            defined_symbols_.resize(std::max<size_t>(header.symbol_id + 1, SymbolTable::instance().size()), 0);
+        }
+        if (!defined_symbols_[header.symbol_id]) {
+            TickJournalRecordHeader definition{};
+            definition.length = static_cast<uint16_t>(symbol.size());
+            definition.stream = kSymbolDefinition;
+            definition.symbol_id = header.symbol_id;
+            definition.recv_time_us = header.recv_time_us;
+            writeRecord(definition, symbol.data());
+            defined_symbols_[header.symbol_id] = 1;
+        }
+
+        writeRecord(header, payload);
+        ++record_count_;
+    }
+}
+
+bool TickJournal::ensureSpace(size_t bytes) {
+    // 预留一个全零记录头作为段结束标记
+    const size_t required = bytes + sizeof(TickJournalRecordHeader);
+    if (segment_ && write_offset_ + required <= segment_->size()) {
+        return true;
+    }
+
+    if (sizeof(TickJournalSegmentHeader) + required > segment_bytes_) {
+        LOG_WARN(module_name, "记录长度 {} 超过段容量, 不写入日志", bytes);
+        return false;
+    }
+
+    closeSegment();
+    return openSegment();
+}
+
+void TickJournal::writeRecord(const TickJournalRecordHeader& header, const char* payload) {
+    char* dest = segment_->data() + write_offset_;
+    std::memcpy(dest, &header, sizeof(header));
+    std::memcpy(dest + sizeof(header), payload, header.length);
+    write_offset_ += sizeof(header) + header.length;
+}
+
+bool TickJournal::openSegment() {
+    std::string path = session_dir_ + "/" + segmentFileName(segment_index_);
+
+    auto segment = std::make_unique<Segment>();
+    if (!segment->create(path, segment_bytes_)) {
+        LOG_ERROR(module_name, "无法创建日志段文件 {}", path);
+        return false;
+    }
+
+    TickJournalSegmentHeader header{};
+    std::memcpy(header.magic, kSegmentMagic, sizeof(header.magic));
+    header.version = kVersion;
+    header.segment_index = segment_index_;
+    header.header_bytes = sizeof(TickJournalSegmentHeader);
+    header.created_time_us = nowMicros();
+    std::memcpy(segment->data(), &header, sizeof(header));
+
+    segment_ = std::move(segment);
+    write_offset_ = sizeof(TickJournalSegmentHeader);
+    std::fill(defined_symbols_.begin(), defined_symbols_.end(), 0);
+    ++segment_index_;
+    return true;
+}
+
+void TickJournal::closeSegment() {
+    if (segment_) {
+        segment_->close(write_offset_);
+        segment_.reset();
+    }
+}
+
+// ------------------------------------------------------------
+// TickJournalReader
+// ------------------------------------------------------------
+
+TickJournalReader::TickJournalReader(const std::string& session_dir) {
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(session_dir, ec)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".tj") {
+            segment_files_.push_back(entry.path().string());
+        }
+    }
+    if (ec) {
+        LOG_ERROR(module_name, "无法读取日志目录 {}: {}", session_dir, ec.message());
+    }
+
+    // 文件名带定长序号, 字典序即写入顺序
+    std::sort(segment_files_.begin(), segment_files_.end());
+}
+
+size_t TickJournalReader::forEach(const std::function<void(const Record&)>& on_record) {
+    size_t count = 0;
+
+    for (const std::string& path : segment_files_) {
+        MappedFile file;
+        if (!file.openReadOnly(path) || file.size() < sizeof(TickJournalSegmentHeader)) {
+            LOG_WARN(module_name, "跳过无法读取的日志段: {}", path);
+            continue;
+        }
+
+        TickJournalSegmentHeader segment_header;
+        std::memcpy(&segment_header, file.data(), sizeof(segment_header));
+        if (std::memcmp(segment_header.magic, kSegmentMagic, sizeof(kSegmentMagic)) != 0 ||
+            segment_header.version != TickJournal::kVersion) {
+            LOG_WARN(module_name, "日志段格式不匹配: {}", path);
+            continue;
+        }
+
+        // 合约定义按段记录, 每个段单独建表
+        std::unordered_map<SymbolId, std::string> symbols;
+
+        size_t offset = segment_header.header_bytes;
+        while (offset + sizeof(TickJournalRecordHeader) <= file.size()) {
+            TickJournalRecordHeader header;
+            std::memcpy(&header, file.data() + offset, sizeof(header));
+            if (header.length == 0 || offset + sizeof(header) + header.length > file.size()) {
+                break; // 段结束或未写完的尾部
+            }
+
+            std::string_view payload(file.data() + offset + sizeof(header), header.length);
+            offset += sizeof(header) + header.length;
+
+            if (header.stream == TickJournal::kSymbolDefinition) {
+                symbols[header.symbol_id] = std::string(payload);
+                continue;
+            }
+
+            auto it = symbols.find(header.symbol_id);
+            Record record{};
+            record.stream = header.stream;
+            record.symbol_id = header.symbol_id;
+            record.symbol = it != symbols.end() ? std::string_view(it->second) : std::string_view();
+            record.recv_time_us = header.recv_time_us;
+            record.text = payload;
+            on_record(record);
+            ++count;
+        }
+    }
+
+    return count;
+}
+
+size_t convertTickJournalToText(const std::string& session_dir, const std::string& output_dir) {
+    std::error_code ec;
+    std::filesystem::create_directories(output_dir, ec);
+
+    TickJournalReader reader(session_dir);
+    std::unordered_map<std::string, std::ofstream> outputs;
+
+    size_t count = reader.forEach([&](const TickJournalReader::Record& record) {
+        std::string path = output_dir + "/" + std::string(record.symbol) +
+            (record.stream == streamIndex(DataMessage::MessageType::TRADE) ? "_trade_tcp.txt" : "_order_tcp.txt");
+
+        auto it = outputs.find(path);
+        if (it == outputs.end()) {
+            it = outputs.emplace(path, std::ofstream(path, std::ios::app)).first;
+            if (!it->second.is_open()) {
+                LOG_ERROR(module_name, "无法打开文件 {} 进行写入", path);
+            }
+        }
+        it->second.write(record.text.data(), static_cast<std::streamsize>(record.text.size()));
+        it->second.put('\n');
+    });
+
+    LOG_INFO(module_name, "日志 {} 转换完成, 共 {} 条记录, {} 个文件", session_dir, count, outputs.size());
+    return count;
+}
@@ -0,0 +1,147 @@
+// TripleBufferSlotTest.cpp
+// TripleBufferSlot 并发压力测试: 一个写者持续发布, 多个读者校验钉住的缓冲区内容一致且版本不回退
+// 写者发布到每个读者都在写者运行期间完成至少 kMinOverlapReads 次读取、看到至少 kMinVersionChanges 次版本变化,
+// 或用完 kTimeBudget 为止; 任一读者未达到这两个下限时判为失败, 避免读写线程几乎没有交错时测试照样通过
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "TripleBufferSlot.h"
+
+namespace {
+
+constexpr int kReaders = 3;
+constexpr long kMinOverlapReads = 50000;
+constexpr long kMinVersionChanges = 5000;
+constexpr auto kTimeBudget = std::chrono::seconds(1);
+
+// 单个读者在写者运行期间的统计, 各占一条缓存行
+struct alignas(64) ReaderOverlap {
+    std::atomic<long> reads{0};           // 写者运行期间完成的读取次数
+    std::atomic<long> version_changes{0}; // 写者运行期间相邻两次读取版本不同的次数
+};
+
+// 版本 ver 的内容: 外层 ver % 5 + 1 个元素, 每个内层 ver % 7 + 1 个元素, 值均为 ver
+void fill(std::vector<std::vector<int>>& value, int ver) {
+    value.resize(ver % 5 + 1);
+    for (auto& inner : value) {
+        inner.assign(ver % 7 + 1, ver);
+    }
+}
+
+// 返回内容不一致的元素数, 内容一致时由 ver 带回版本号, 空值为 -1
+long check(const std::vector<std::vector<int>>& value, int& ver) {
+    ver = value.empty() ? -1 : value[0][0];
+    if (ver < 0) {
+        return 0;
+    }
+
+    long torn = (static_cast<int>(value.size()) != ver % 5 + 1) ? 1 : 0;
+    for (const auto& inner : value) {
+        if (static_cast<int>(inner.size()) != ver % 7 + 1) {
+            ++torn;
+        }
+        for (int x : inner) {
+            if (x != ver) {
+                ++torn;
+            }
+        }
+    }
+    return torn;
+}
+
+} // namespace
+
+int main() {
+    TripleBufferSlot<std::vector<std::vector<int>>> slot;
+    std::atomic<bool> writer_active{true};
+    std::atomic<bool> done{false};
+    std::atomic<long> torn{0};
+    std::atomic<long> regressed{0};
+    std::atomic<long> reads{0};
+    ReaderOverlap overlap[kReaders];
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < kReaders; ++r) {
+        readers.emplace_back([&, r] {
+            int last = -1;
+            for (long n = 1; !done.load(std::memory_order_acquire); ++n) {
+                const bool racing = writer_active.load(std::memory_order_acquire);
+                auto handle = slot.read();
+                int ver = -1;
+                torn += check(*handle, ver);
+                if (ver < last) {
+                    ++regressed;
+                }
+                if (racing) {
+                    overlap[r].reads.fetch_add(1, std::memory_order_relaxed);
+                    if (ver != last) {
+                        overlap[r].version_changes.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+                last = ver;
+                ++reads;
+                if (n % 64 == 0) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    auto readers_satisfied = [&] {
+        for (const ReaderOverlap& o : overlap) {
+            if (o.reads.load(std::memory_order_relaxed) < kMinOverlapReads ||
+                o.version_changes.load(std::memory_order_relaxed) < kMinVersionChanges) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    const auto deadline = std::chrono::steady_clock::now() + kTimeBudget;
+    int ver = 0;
+    for (;; ++ver) {
+        fill(slot.beginWrite(), ver);
+        slot.publish();
+        if (ver % 16 == 15) {
+            if (readers_satisfied() || std::chrono::steady_clock::now() >= deadline) {
+                break;
+            }
+            // 核心数少于线程数时读写双方都定期让出 CPU, 否则各自跑满时间片, 读者很少看到版本变化
+            std::this_thread::yield();
+        }
+    }
+    writer_active.store(false, std::memory_order_release);
+    done.store(true, std::memory_order_release);
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    int final_ver = -1;
+    long final_torn = check(*slot.read(), final_ver);
+
+    bool overlapped = true;
+    for (int r = 0; r < kReaders; ++r) {
+        long overlap_reads = overlap[r].reads.load();
+        long version_changes = overlap[r].version_changes.load();
+        std::printf("reader %d: overlap_reads=%ld version_changes=%ld\n", r, overlap_reads, version_changes);
+        if (overlap_reads < kMinOverlapReads || version_changes < kMinVersionChanges) {
+            overlapped = false;
+        }
+    }
+
+    std::printf("versions=%d reads=%ld torn=%ld regressed=%ld final=%d\n",
+        ver + 1, reads.load(), torn.load(), regressed.load(), final_ver);
+    if (!overlapped) {
+        std::printf("FAILED: 读者与写者交错不足, 至少需要 %ld 次读取与 %ld 次版本变化\n", kMinOverlapReads, kMinVersionChanges);
+        return 1;
+    }
+    if (torn.load() != 0 || regressed.load() != 0 || final_torn != 0 || final_ver != ver) {
+        std::printf("FAILED\n");
+        return 1;
+    }
+    std::printf("PASSED\n");
+    return 0;
+}